@@ -0,0 +1,55 @@
+"""
+Micro-benchmark of bind latency for a warm delta_classic table.
+
+Usage:
+    python benchmark/bind_benchmark.py [--path PATH] [--table main.table_a] [--iterations 20000]
+
+Each iteration prepares a point query, which parses, binds and plans it without reading
+any data. The same query against a native DuckDB table with the same columns is the
+baseline, so the difference is the cost of the delta_classic catalog indirection. With
+PIN_SNAPSHOT a warm bind reuses the cached internal table entry.
+"""
+import argparse
+import os
+import time
+
+import duckdb
+
+DEFAULT_PATH = os.path.join(os.path.dirname(__file__), "..", "test", "data", "single_schema")
+
+
+def time_binds(con, table, iterations):
+    query = f"PREPARE bench_query AS SELECT * FROM {table} WHERE id = $1"
+    # Warm up: attach the table and load its snapshot
+    con.execute(query)
+    start = time.perf_counter()
+    for _ in range(iterations):
+        con.execute(query)
+    return (time.perf_counter() - start) / iterations * 1e6
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--extension", default=os.environ.get(
+        "DELTA_CLASSIC_EXTENSION_PATH", "build/release/extension/delta_classic/delta_classic.duckdb_extension"))
+    parser.add_argument("--path", default=DEFAULT_PATH, help="directory of Delta tables (local or remote)")
+    parser.add_argument("--table", default="main.table_a", help="schema.table to bind")
+    parser.add_argument("--iterations", type=int, default=20000)
+    args = parser.parse_args()
+
+    print(f"{'mode':>12} {'us/bind':>10}")
+    for mode, options in [("unpinned", ""), ("pinned", ", PIN_SNAPSHOT")]:
+        con = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+        con.execute(f"LOAD '{args.extension}'")
+        con.execute(f"ATTACH '{args.path}' AS bench (TYPE delta_classic{options})")
+        table = f"bench.{args.table}"
+        if mode == "unpinned":
+            # Same columns in a native table, for the baseline
+            con.execute(f"CREATE TABLE native AS SELECT * FROM {table} LIMIT 0")
+            print(f"{'native':>12} {time_binds(con, 'native', args.iterations):>10.1f}")
+        print(f"{mode:>12} {time_binds(con, table, args.iterations):>10.1f}")
+        con.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+"""
+Benchmark delta_classic catalog memory and discovery-to-ready time against table count.
+
+Usage:
+    python benchmark/catalog_benchmark.py [--path PATH] [--tables 10000,100000] [--threads 64]
+
+Without --path, synthetic layouts are generated in a temp directory by copying the
+_delta_log of test/data/single_schema/table_a (the first table also gets its data
+file, so it can be queried). Each measurement runs in a fresh process and reports:
+
+    ready     time from ATTACH until a point query on one table returns
+    ready_mb  resident memory added by ATTACH and the point query
+    browse    time to list every table through duckdb_tables()
+    browse_mb resident memory after browsing, which creates the catalog entry of every table
+
+Discovered tables are held in a compact index and get their catalog entry on first
+lookup, so ready_mb should stay far below browse_mb as the table count grows.
+"""
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+SOURCE_TABLE = os.path.join(os.path.dirname(__file__), "..", "test", "data", "single_schema", "table_a")
+
+
+def make_layout(root, table_count):
+    shutil.copytree(SOURCE_TABLE, os.path.join(root, "table_00000"))
+    for i in range(1, table_count):
+        shutil.copytree(os.path.join(SOURCE_TABLE, "_delta_log"), os.path.join(root, f"table_{i:05d}", "_delta_log"))
+
+
+def resident_mb():
+    with open("/proc/self/status") as f:
+        for line in f:
+            if line.startswith("VmRSS:"):
+                return int(line.split()[1]) / 1024
+    return 0.0
+
+
+def measure(extension_path, path, threads):
+    import duckdb
+
+    con = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+    con.execute(f"LOAD '{extension_path}'")
+    baseline = resident_mb()
+
+    start = time.perf_counter()
+    con.execute(f"ATTACH '{path}' AS bench (TYPE delta_classic, DISCOVERY_THREADS {threads})")
+    con.execute("SELECT COUNT(*) FROM bench.main.table_00000").fetchone()
+    ready = time.perf_counter() - start
+    ready_mb = resident_mb() - baseline
+
+    start = time.perf_counter()
+    tables = con.execute("SELECT COUNT(*) FROM duckdb_tables() WHERE database_name = 'bench'").fetchone()[0]
+    browse = time.perf_counter() - start
+    browse_mb = resident_mb() - baseline
+    con.close()
+    return {"tables": tables, "ready": ready, "ready_mb": ready_mb, "browse": browse, "browse_mb": browse_mb}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--extension", default=os.environ.get(
+        "DELTA_CLASSIC_EXTENSION_PATH", "build/release/extension/delta_classic/delta_classic.duckdb_extension"))
+    parser.add_argument("--path", help="existing directory of Delta tables (local or remote)")
+    parser.add_argument("--tables", default="10000,100000")
+    parser.add_argument("--threads", type=int, default=64)
+    parser.add_argument("--measure", help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.measure:
+        print(json.dumps(measure(args.extension, args.measure, args.threads)))
+        return
+
+    layouts = []
+    temp_root = None
+    if args.path:
+        layouts.append(args.path)
+    else:
+        temp_root = tempfile.mkdtemp(prefix="dc_catalog_")
+        for count in [int(t) for t in args.tables.split(",")]:
+            root = os.path.join(temp_root, f"n{count}")
+            make_layout(root, count)
+            layouts.append(root)
+
+    try:
+        print(f"{'tables':>8} {'ready':>10} {'ready_mb':>10} {'browse':>10} {'browse_mb':>10}")
+        for path in layouts:
+            # A fresh process per layout, so resident memory is not shared with earlier runs
+            output = subprocess.check_output([sys.executable, __file__, "--extension", args.extension,
+                                              "--threads", str(args.threads), "--measure", path])
+            r = json.loads(output)
+            print(f"{r['tables']:>8} {r['ready']:>10.3f} {r['ready_mb']:>10.1f} {r['browse']:>10.3f} "
+                  f"{r['browse_mb']:>10.1f}")
+    finally:
+        if temp_root:
+            shutil.rmtree(temp_root)
+
+
+if __name__ == "__main__":
+    main()
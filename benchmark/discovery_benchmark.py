@@ -0,0 +1,73 @@
+"""
+Benchmark delta_classic discovery time against table count and DISCOVERY_THREADS.
+
+Usage:
+    python benchmark/discovery_benchmark.py [--path PATH] [--tables 100,400,800] [--threads 1,8,64]
+
+Without --path, synthetic layouts are generated in a temp directory by copying the
+_delta_log of test/data/single_schema/table_a. Local storage answers each probe in
+microseconds, so point --path at an ABFSS/S3 directory of tables to see the effect
+of request latency: discovery time should shrink with DISCOVERY_THREADS instead of
+growing linearly with the number of tables.
+"""
+import argparse
+import os
+import shutil
+import tempfile
+import time
+
+import duckdb
+
+SOURCE_LOG = os.path.join(os.path.dirname(__file__), "..", "test", "data", "single_schema", "table_a", "_delta_log")
+
+
+def make_layout(root, table_count):
+    for i in range(table_count):
+        shutil.copytree(SOURCE_LOG, os.path.join(root, f"table_{i:05d}", "_delta_log"))
+
+
+def time_discovery(extension_path, path, threads):
+    con = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+    con.execute(f"LOAD '{extension_path}'")
+    start = time.perf_counter()
+    con.execute(f"ATTACH '{path}' AS bench (TYPE delta_classic, DISCOVERY_THREADS {threads})")
+    tables = con.execute("SELECT COUNT(*) FROM duckdb_tables() WHERE database_name = 'bench'").fetchone()[0]
+    elapsed = time.perf_counter() - start
+    con.close()
+    return tables, elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--extension", default=os.environ.get(
+        "DELTA_CLASSIC_EXTENSION_PATH", "build/release/extension/delta_classic/delta_classic.duckdb_extension"))
+    parser.add_argument("--path", help="existing directory of Delta tables (local or remote)")
+    parser.add_argument("--tables", default="100,400,800")
+    parser.add_argument("--threads", default="1,8,64")
+    args = parser.parse_args()
+
+    thread_counts = [int(t) for t in args.threads.split(",")]
+    layouts = []
+    temp_root = None
+    if args.path:
+        layouts.append(args.path)
+    else:
+        temp_root = tempfile.mkdtemp(prefix="dc_discovery_")
+        for count in [int(t) for t in args.tables.split(",")]:
+            root = os.path.join(temp_root, f"n{count}")
+            make_layout(root, count)
+            layouts.append(root)
+
+    try:
+        print(f"{'tables':>8} {'threads':>8} {'seconds':>10}")
+        for path in layouts:
+            for threads in thread_counts:
+                tables, elapsed = time_discovery(args.extension, path, threads)
+                print(f"{tables:>8} {threads:>8} {elapsed:>10.3f}")
+    finally:
+        if temp_root:
+            shutil.rmtree(temp_root)
+
+
+if __name__ == "__main__":
+    main()
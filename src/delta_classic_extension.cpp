@@ -1,5 +1,8 @@
 #include "delta_classic_extension.hpp"
+#include "delta_classic_functions.hpp"
+#include "delta_classic_optimizer.hpp"
 #include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_snapshot_registry.hpp"
 #include "storage/delta_classic_transaction_manager.hpp"
 
 #include "duckdb/main/extension/extension_loader.hpp"
@@ -7,9 +10,40 @@
 #include "duckdb/parser/parsed_data/attach_info.hpp"
 #include "duckdb/storage/storage_extension.hpp"
 #include "duckdb/main/attached_database.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 
 namespace duckdb {
 
+//! Accepts either a single pattern ('a/*,b/*' is split on commas) or a list of patterns
+static vector<string> ParsePatternList(const Value &value) {
+	vector<string> result;
+	if (value.type().id() == LogicalTypeId::LIST) {
+		for (auto &child : ListValue::GetChildren(value)) {
+			result.push_back(child.ToString());
+		}
+		return result;
+	}
+	for (auto &pattern : StringUtil::Split(value.ToString(), ',')) {
+		StringUtil::Trim(pattern);
+		if (!pattern.empty()) {
+			result.push_back(pattern);
+		}
+	}
+	return result;
+}
+
+//! Parses an interval option such as '30 seconds' into microseconds
+static int64_t ParsePositiveInterval(const string &option, const Value &value) {
+	auto micros = Interval::GetMicro(IntervalValue::Get(value.DefaultCastAs(LogicalType::INTERVAL)));
+	if (micros <= 0) {
+		throw InvalidInputException("%s must be positive, got '%s'", option, value.ToString());
+	}
+	return micros;
+}
+
 static unique_ptr<Catalog> DeltaClassicAttach(optional_ptr<StorageExtensionInfo> storage_info, ClientContext &context,
                                               AttachedDatabase &db, const string &name, AttachInfo &info,
                                               AttachOptions &options) {
@@ -22,15 +56,167 @@ static unique_ptr<Catalog> DeltaClassicAttach(optional_ptr<StorageExtensionInfo>
 		base_path.pop_back();
 	}
 
+	DeltaClassicOptions dc_options;
+
 	// Check for PIN_SNAPSHOT in options
-	bool pin_snapshot = false;
 	auto it = options.options.find("pin_snapshot");
 	if (it != options.options.end()) {
-		pin_snapshot = true;
+		dc_options.pin_snapshot = true;
+		options.options.erase(it);
+	}
+
+	// MAX_STALENESS pins snapshots, but only for as long as the given interval, e.g. '30 seconds'
+	it = options.options.find("max_staleness");
+	if (it != options.options.end()) {
+		dc_options.max_staleness = ParsePositiveInterval("MAX_STALENESS", it->second);
+		dc_options.pin_snapshot = true;
+		options.options.erase(it);
+	}
+
+	// HANDOFF keeps the pinned snapshots attached after DETACH for the next ATTACH (OR REPLACE), e.g. '1 minute'
+	it = options.options.find("handoff");
+	if (it != options.options.end()) {
+		dc_options.handoff = ParsePositiveInterval("HANDOFF", it->second);
+		dc_options.pin_snapshot = true;
+		options.options.erase(it);
+	}
+
+	// AS_OF_TIMESTAMP reads every table as it was at one point in time, e.g. for reproducible reports
+	it = options.options.find("as_of_timestamp");
+	if (it != options.options.end()) {
+		auto timestamp = TimestampValue::Get(it->second.DefaultCastAs(LogicalType::TIMESTAMP));
+		dc_options.as_of = true;
+		dc_options.as_of_timestamp_ms = Timestamp::GetEpochMs(timestamp);
+		options.options.erase(it);
+	}
+	if (dc_options.as_of && dc_options.pin_snapshot) {
+		throw InvalidInputException("AS_OF_TIMESTAMP cannot be combined with PIN_SNAPSHOT, MAX_STALENESS or HANDOFF");
+	}
+
+	// PREWARM attaches every table in the background, so first queries do not pay for it
+	it = options.options.find("prewarm");
+	if (it != options.options.end()) {
+		dc_options.prewarm = true;
+		options.options.erase(it);
+	}
+
+	// DISCOVERY_THREADS bounds the number of concurrent storage requests during discovery
+	it = options.options.find("discovery_threads");
+	if (it != options.options.end()) {
+		auto threads = it->second.GetValue<int64_t>();
+		if (threads < 1) {
+			throw InvalidInputException("DISCOVERY_THREADS must be at least 1, got %lld", threads);
+		}
+		dc_options.discovery_threads = idx_t(threads);
+		options.options.erase(it);
+	}
+
+	it = options.options.find("discovery_mode");
+	if (it != options.options.end()) {
+		auto mode = StringUtil::Lower(it->second.ToString());
+		if (mode == "walk") {
+			dc_options.discovery_mode = DeltaClassicDiscoveryMode::WALK;
+		} else if (mode == "recursive") {
+			dc_options.discovery_mode = DeltaClassicDiscoveryMode::RECURSIVE;
+		} else {
+			throw InvalidInputException("Unknown DISCOVERY_MODE '%s', expected 'walk' or 'recursive'", mode);
+		}
+		options.options.erase(it);
+	}
+
+	// INCLUDE / EXCLUDE restrict discovery to matching table paths relative to base_path
+	it = options.options.find("include");
+	if (it != options.options.end()) {
+		dc_options.include_patterns = ParsePatternList(it->second);
+		options.options.erase(it);
+	}
+	it = options.options.find("exclude");
+	if (it != options.options.end()) {
+		dc_options.exclude_patterns = ParsePatternList(it->second);
 		options.options.erase(it);
 	}
 
-	return make_uniq<DeltaClassicCatalog>(db, base_path, options.access_mode, pin_snapshot);
+	// MAX_ATTACHED_TABLES bounds how many tables stay attached; the least recently used ones are detached
+	it = options.options.find("max_attached_tables");
+	if (it != options.options.end()) {
+		auto max_tables = it->second.GetValue<int64_t>();
+		if (max_tables < 1) {
+			throw InvalidInputException("MAX_ATTACHED_TABLES must be at least 1, got %lld", max_tables);
+		}
+		dc_options.max_attached_tables = idx_t(max_tables);
+		options.options.erase(it);
+	}
+
+	// DISCOVERY_CACHE keeps the discovered listing on local disk for the next attach
+	it = options.options.find("discovery_cache");
+	if (it != options.options.end()) {
+		dc_options.discovery_cache = it->second.ToString();
+		options.options.erase(it);
+	}
+
+	// REFRESH_INTERVAL picks up added and removed tables in the background, e.g. '5 minutes'
+	it = options.options.find("refresh_interval");
+	if (it != options.options.end()) {
+		dc_options.refresh_interval = ParsePositiveInterval("REFRESH_INTERVAL", it->second);
+		options.options.erase(it);
+	}
+
+	// LOCAL_CACHE keeps the data files' blocks on local disk, e.g. an NVMe drive in front of object storage
+	it = options.options.find("local_cache");
+	if (it != options.options.end()) {
+		dc_options.local_cache = it->second.ToString();
+		options.options.erase(it);
+	}
+	it = options.options.find("local_cache_size");
+	if (it != options.options.end()) {
+		dc_options.local_cache_size = DBConfig::ParseMemoryLimit(it->second.ToString());
+		if (dc_options.local_cache_size == 0) {
+			throw InvalidInputException("LOCAL_CACHE_SIZE must be positive, got '%s'", it->second.ToString());
+		}
+		options.options.erase(it);
+	}
+
+	// INDEX_DIRECTORY keeps key indexes in a local directory instead of next to the tables
+	it = options.options.find("index_directory");
+	if (it != options.options.end()) {
+		dc_options.index_directory = it->second.ToString();
+		options.options.erase(it);
+	}
+
+	// PREFETCH_FOOTERS reads the data files' footers concurrently before the first scan needs them
+	it = options.options.find("prefetch_footers");
+	if (it != options.options.end()) {
+		dc_options.prefetch_footers = true;
+		options.options.erase(it);
+	}
+
+	// CACHE_SMALL_TABLES keeps small (e.g. dimension) tables in memory, e.g. '64MB' of data files
+	it = options.options.find("cache_small_tables");
+	if (it != options.options.end()) {
+		dc_options.cache_small_tables = DBConfig::ParseMemoryLimit(it->second.ToString());
+		options.options.erase(it);
+	}
+	it = options.options.find("cache_small_tables_size");
+	if (it != options.options.end()) {
+		dc_options.cache_small_tables_size = DBConfig::ParseMemoryLimit(it->second.ToString());
+		if (dc_options.cache_small_tables_size == 0) {
+			throw InvalidInputException("CACHE_SMALL_TABLES_SIZE must be positive, got '%s'", it->second.ToString());
+		}
+		options.options.erase(it);
+	}
+
+	// REPLICA copies every table into a local DuckDB database and serves scans from it
+	it = options.options.find("replica");
+	if (it != options.options.end()) {
+		dc_options.replica = it->second.ToString();
+		options.options.erase(it);
+	}
+	if (!dc_options.replica.empty() && dc_options.as_of) {
+		throw InvalidInputException("REPLICA cannot be combined with AS_OF_TIMESTAMP");
+	}
+
+	auto &snapshots = storage_info->Cast<DeltaClassicSnapshotRegistry>();
+	return make_uniq<DeltaClassicCatalog>(db, base_path, options.access_mode, std::move(dc_options), snapshots);
 }
 
 static unique_ptr<TransactionManager> DeltaClassicCreateTransactionManager(
@@ -44,7 +230,11 @@ static void LoadInternal(ExtensionLoader &loader) {
 	auto extension = make_shared_ptr<StorageExtension>();
 	extension->attach = DeltaClassicAttach;
 	extension->create_transaction_manager = DeltaClassicCreateTransactionManager;
+	// Shared by every delta_classic catalog of this database instance
+	extension->storage_info = make_shared_ptr<DeltaClassicSnapshotRegistry>();
 	StorageExtension::Register(config, "delta_classic", std::move(extension));
+	DeltaClassicOptimizer::Register(config);
+	DeltaClassicFunctions::Register(loader);
 }
 
 void DeltaClassicExtension::Load(ExtensionLoader &loader) {
@@ -0,0 +1,367 @@
+#include "delta_classic_functions.hpp"
+#include "storage/delta_classic_cache_file_system.hpp"
+#include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_key_index.hpp"
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_schema_entry.hpp"
+#include "storage/delta_classic_table_entry.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct RefreshBindData : public TableFunctionData {
+	string catalog_name;
+};
+
+struct SingleRowGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+struct RemovedFilesBindData : public TableFunctionData {
+	vector<DeltaClassicFileChange> removed;
+	string table_path;
+};
+
+struct RemovedFilesGlobalState : public GlobalTableFunctionState {
+	idx_t offset = 0;
+};
+
+struct BuildIndexBindData : public TableFunctionData {
+	optional_ptr<DeltaClassicTableEntry> table;
+	string column;
+};
+
+struct StatsRow {
+	string database_name;
+	string schema_name;
+	string table_name;
+	DeltaClassicMetric metric;
+};
+
+struct StatsBindData : public TableFunctionData {
+	vector<StatsRow> rows;
+};
+
+struct StatsGlobalState : public GlobalTableFunctionState {
+	idx_t offset = 0;
+};
+
+} // namespace
+
+static DeltaClassicCatalog &GetDeltaClassicCatalog(ClientContext &context, const string &name) {
+	auto &catalog = Catalog::GetCatalog(context, name);
+	if (catalog.GetCatalogType() != "delta_classic") {
+		throw InvalidInputException("\"%s\" is not a delta_classic database", name);
+	}
+	return catalog.Cast<DeltaClassicCatalog>();
+}
+
+static unique_ptr<FunctionData> RefreshBind(ClientContext &context, TableFunctionBindInput &input,
+                                            vector<LogicalType> &return_types, vector<string> &names) {
+	if (input.inputs[0].IsNull()) {
+		throw InvalidInputException("delta_classic_refresh requires a database name");
+	}
+	auto result = make_uniq<RefreshBindData>();
+	result->catalog_name = input.inputs[0].ToString();
+	// Fail at bind time for unknown databases
+	GetDeltaClassicCatalog(context, result->catalog_name);
+
+	names = {"schemas_added", "schemas_removed", "tables_added", "tables_removed"};
+	return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> SingleRowInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SingleRowGlobalState>();
+}
+
+static void RefreshFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<SingleRowGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	auto &bind_data = data.bind_data->Cast<RefreshBindData>();
+	auto result = GetDeltaClassicCatalog(context, bind_data.catalog_name).Refresh(context);
+	output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(result.schemas_added)));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(result.schemas_removed)));
+	output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(result.tables_added)));
+	output.SetValue(3, 0, Value::BIGINT(NumericCast<int64_t>(result.tables_removed)));
+	output.SetCardinality(1);
+	state.finished = true;
+}
+
+//! Resolves 'db.schema.table' through the catalog to a delta_classic table
+static DeltaClassicTableEntry &GetDeltaClassicTable(ClientContext &context, const string &table_name) {
+	auto qualified_name = QualifiedName::Parse(table_name);
+	auto &entry = Catalog::GetEntry<TableCatalogEntry>(context, qualified_name.catalog, qualified_name.schema,
+	                                                   qualified_name.name);
+	if (entry.ParentCatalog().GetCatalogType() != "delta_classic") {
+		throw InvalidInputException("\"%s\" is not a table of a delta_classic database", table_name);
+	}
+	return entry.Cast<DeltaClassicTableEntry>();
+}
+
+//! Resolves 'db.schema.table' to a delta_classic table and reads the changes of its commits from_version through
+//! to_version (the latest if not given)
+static DeltaClassicChanges ReadTableChanges(ClientContext &context, TableFunctionBindInput &input,
+                                            const string &function_name, DeltaClassicTableEntry *&table,
+                                            shared_ptr<DeltaClassicSnapshot> &metadata) {
+	for (auto &value : input.inputs) {
+		if (value.IsNull()) {
+			throw InvalidInputException("%s does not accept NULL arguments", function_name);
+		}
+	}
+	table = &GetDeltaClassicTable(context, input.inputs[0].ToString());
+	auto &dc_catalog = table->ParentCatalog().Cast<DeltaClassicCatalog>();
+
+	auto from_version = input.inputs[1].GetValue<int64_t>();
+	if (from_version < 0) {
+		throw InvalidInputException("%s: from_version must not be negative", function_name);
+	}
+	DeltaClassicLogReader reader(DatabaseInstance::GetDatabase(context), FileSystem::GetFileSystem(context),
+	                             table->delta_table_path, dc_catalog.options.discovery_threads);
+	auto to_version = input.inputs.size() > 2 ? input.inputs[2].GetValue<int64_t>() : reader.GetLatestVersion();
+	metadata = reader.ReadMetadata();
+	return reader.ReadChanges(from_version, to_version);
+}
+
+//! delta_classic_changes is replaced by a query reading the added files with read_parquet, joined to the version
+//! and partition values of each file from the log
+static unique_ptr<TableRef> ChangesBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	DeltaClassicTableEntry *table;
+	shared_ptr<DeltaClassicSnapshot> metadata;
+	auto changes = ReadTableChanges(context, input, "delta_classic_changes", table, metadata);
+	if (metadata->HasColumnMapping()) {
+		throw NotImplementedException("delta_classic_changes does not support tables with column mapping");
+	}
+	ColumnList columns;
+	if (!metadata->TryGetColumns(columns)) {
+		throw NotImplementedException("delta_classic_changes: the schema of \"%s\" holds unsupported types",
+		                              table->delta_table_path);
+	}
+
+	for (auto &change : changes.added) {
+		if (change.file.has_deletion_vector) {
+			// Reading the file would return the rows the deletion vector removes
+			throw NotImplementedException(
+			    "delta_classic_changes does not support deletion vectors (file \"%s\" added in version %lld)",
+			    change.file.path, change.version);
+		}
+	}
+	auto query = metadata->GetFilesQuery(table->delta_table_path, columns, changes.added);
+
+	Parser parser;
+	parser.ParseQuery(query);
+	auto select = unique_ptr_cast<SQLStatement, SelectStatement>(std::move(parser.statements[0]));
+	return make_uniq<SubqueryRef>(std::move(select));
+}
+
+static unique_ptr<FunctionData> RemovedFilesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<RemovedFilesBindData>();
+	DeltaClassicTableEntry *table;
+	shared_ptr<DeltaClassicSnapshot> metadata;
+	auto changes = ReadTableChanges(context, input, "delta_classic_removed_files", table, metadata);
+	result->removed = std::move(changes.removed);
+	result->table_path = table->delta_table_path;
+
+	names = {"_commit_version", "path", "size"};
+	return_types = {LogicalType::BIGINT, LogicalType::VARCHAR, LogicalType::BIGINT};
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> RemovedFilesInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<RemovedFilesGlobalState>();
+}
+
+static void RemovedFilesFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<RemovedFilesGlobalState>();
+	auto &bind_data = data.bind_data->Cast<RemovedFilesBindData>();
+	idx_t count = 0;
+	for (; state.offset < bind_data.removed.size() && count < STANDARD_VECTOR_SIZE; state.offset++, count++) {
+		auto &change = bind_data.removed[state.offset];
+		output.SetValue(0, count, Value::BIGINT(change.version));
+		output.SetValue(1, count, Value(DeltaClassicSnapshot::GetAbsolutePath(bind_data.table_path, change.file.path)));
+		output.SetValue(2, count, Value::BIGINT(NumericCast<int64_t>(change.file.size)));
+	}
+	output.SetCardinality(count);
+}
+
+static unique_ptr<FunctionData> BuildIndexBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	if (input.inputs[0].IsNull() || input.inputs[1].IsNull()) {
+		throw InvalidInputException("delta_classic_build_index requires a table and a column name");
+	}
+	auto result = make_uniq<BuildIndexBindData>();
+	result->table = &GetDeltaClassicTable(context, input.inputs[0].ToString());
+	result->column = input.inputs[1].ToString();
+
+	names = {"version", "files_indexed", "files_total"};
+	return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+	return std::move(result);
+}
+
+static void BuildIndexFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<SingleRowGlobalState>();
+	if (state.finished) {
+		return;
+	}
+	auto &bind_data = data.bind_data->Cast<BuildIndexBindData>();
+	auto &table = *bind_data.table;
+	auto &dc_catalog = table.ParentCatalog().Cast<DeltaClassicCatalog>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// The index covers the latest version; files committed later are scanned until the index is built again
+	DeltaClassicLogReader reader(db, fs, table.delta_table_path, dc_catalog.options.discovery_threads);
+	auto snapshot = reader.ReadSnapshot();
+	if (snapshot->HasColumnMapping()) {
+		throw NotImplementedException("delta_classic_build_index does not support tables with column mapping");
+	}
+	table.LoadColumns(db, fs);
+	if (!table.GetColumns().ColumnExists(bind_data.column)) {
+		throw InvalidInputException("Table \"%s\" has no column \"%s\"", table.name, bind_data.column);
+	}
+	auto &column = table.GetColumns().GetColumn(bind_data.column);
+	if (snapshot->IsPartitionColumn(column.Name())) {
+		throw InvalidInputException("\"%s\" is a partition column; the Delta log already selects files by it",
+		                            column.Name());
+	}
+
+	// Files indexed before keep their entries, so rebuilding after a few commits reads only the new files
+	auto path = DeltaClassicKeyIndex::GetPath(fs, dc_catalog.options.index_directory, table.delta_table_path,
+	                                          column.Name());
+	auto index = DeltaClassicKeyIndex::Read(fs, path, column.Name(), column.Type());
+	if (!index) {
+		index = make_uniq<DeltaClassicKeyIndex>(column.Name(), column.Type());
+	}
+	auto files_indexed = index->Update(db, table.delta_table_path, *snapshot, dc_catalog.options.discovery_threads);
+	index->Write(fs, path);
+
+	output.SetValue(0, 0, Value::BIGINT(index->version));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(files_indexed)));
+	output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(index->files.size())));
+	output.SetCardinality(1);
+	table.SetKeyIndex(shared_ptr<DeltaClassicKeyIndex>(index.release()));
+	state.finished = true;
+}
+
+static void AddStatsRows(vector<StatsRow> &rows, DeltaClassicStats &stats, const string &database_name,
+                         const string &schema_name, const string &table_name) {
+	for (auto &metric : stats.GetMetrics()) {
+		rows.push_back(StatsRow {database_name, schema_name, table_name, std::move(metric)});
+	}
+}
+
+static void AddCatalogStats(vector<StatsRow> &rows, DeltaClassicCatalog &catalog) {
+	auto database_name = catalog.GetName();
+	AddStatsRows(rows, catalog.stats, database_name, string(), string());
+	if (catalog.cache_file_system) {
+		AddStatsRows(rows, catalog.cache_file_system->stats, database_name, string(), string());
+	}
+	// Only what was discovered and looked up so far: reporting must not list or attach anything
+	for (auto &schema : catalog.GetLoadedSchemas()) {
+		AddStatsRows(rows, schema.get().stats, database_name, schema.get().name, string());
+		for (auto &table : schema.get().tables.GetLoadedEntries()) {
+			AddStatsRows(rows, table.get().stats, database_name, schema.get().name, table.get().name);
+		}
+	}
+}
+
+static unique_ptr<FunctionData> StatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<StatsBindData>();
+	if (!input.inputs.empty()) {
+		if (input.inputs[0].IsNull()) {
+			throw InvalidInputException("delta_classic_stats requires a database name");
+		}
+		AddCatalogStats(result->rows, GetDeltaClassicCatalog(context, input.inputs[0].ToString()));
+	} else {
+		for (auto &database : DatabaseManager::Get(context).GetDatabases(context)) {
+			auto &catalog = database->GetCatalog();
+			if (catalog.GetCatalogType() == "delta_classic") {
+				AddCatalogStats(result->rows, catalog.Cast<DeltaClassicCatalog>());
+			}
+		}
+	}
+
+	names = {"database_name", "schema_name", "table_name", "metric", "unit", "count",
+	         "total", "min", "max", "p50", "p99"};
+	return_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+	                LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT};
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> StatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<StatsGlobalState>();
+}
+
+static void StatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<StatsGlobalState>();
+	auto &bind_data = data.bind_data->Cast<StatsBindData>();
+	idx_t count = 0;
+	for (; state.offset < bind_data.rows.size() && count < STANDARD_VECTOR_SIZE; state.offset++, count++) {
+		auto &row = bind_data.rows[state.offset];
+		auto &metric = row.metric;
+		output.SetValue(0, count, Value(row.database_name));
+		output.SetValue(1, count, row.schema_name.empty() ? Value() : Value(row.schema_name));
+		output.SetValue(2, count, row.table_name.empty() ? Value() : Value(row.table_name));
+		output.SetValue(3, count, Value(metric.name));
+		output.SetValue(4, count, Value(metric.unit));
+		output.SetValue(5, count, Value::UBIGINT(metric.count));
+		// Counters only have a count
+		output.SetValue(6, count, metric.is_histogram ? Value::UBIGINT(metric.total) : Value());
+		output.SetValue(7, count, metric.is_histogram ? Value::UBIGINT(metric.min) : Value());
+		output.SetValue(8, count, metric.is_histogram ? Value::UBIGINT(metric.max) : Value());
+		output.SetValue(9, count, metric.is_histogram ? Value::UBIGINT(metric.p50) : Value());
+		output.SetValue(10, count, metric.is_histogram ? Value::UBIGINT(metric.p99) : Value());
+	}
+	output.SetCardinality(count);
+}
+
+void DeltaClassicFunctions::Register(ExtensionLoader &loader) {
+	// CALL delta_classic_refresh('db') picks up tables added or removed since the database was attached
+	TableFunction refresh("delta_classic_refresh", {LogicalType::VARCHAR}, RefreshFunction, RefreshBind, SingleRowInit);
+	loader.RegisterFunction(refresh);
+
+	// delta_classic_changes('db.schema.table', from_version [, to_version]) reads the rows of the files the
+	// commits in the range added, and delta_classic_removed_files lists the files they removed
+	TableFunctionSet changes("delta_classic_changes");
+	TableFunctionSet removed_files("delta_classic_removed_files");
+	for (auto &arguments : {vector<LogicalType> {LogicalType::VARCHAR, LogicalType::BIGINT},
+	                        vector<LogicalType> {LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::BIGINT}}) {
+		TableFunction changes_function(arguments, nullptr, nullptr);
+		changes_function.bind_replace = ChangesBindReplace;
+		changes.AddFunction(changes_function);
+		removed_files.AddFunction(TableFunction(arguments, RemovedFilesFunction, RemovedFilesBind, RemovedFilesInit));
+	}
+	loader.RegisterFunction(changes);
+	loader.RegisterFunction(removed_files);
+
+	// CALL delta_classic_build_index('db.schema.table', 'column') builds or updates the column's key index
+	TableFunction build_index("delta_classic_build_index", {LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                          BuildIndexFunction, BuildIndexBind, SingleRowInit);
+	loader.RegisterFunction(build_index);
+
+	// delta_classic_stats(['db']) reports the timings and counters gathered by the attached catalogs
+	TableFunctionSet stats("delta_classic_stats");
+	stats.AddFunction(TableFunction({}, StatsFunction, StatsBind, StatsInit));
+	stats.AddFunction(TableFunction({LogicalType::VARCHAR}, StatsFunction, StatsBind, StatsInit));
+	loader.RegisterFunction(stats);
+}
+
+} // namespace duckdb
@@ -0,0 +1,648 @@
+#include "delta_classic_optimizer.hpp"
+#include "storage/delta_classic_cached_scan.hpp"
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_scan_registry.hpp"
+#include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_key_index.hpp"
+#include "storage/delta_classic_table_entry.hpp"
+#include "storage/delta_classic_union_entry.hpp"
+
+#include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/operator/logical_dummy_scan.hpp"
+#include "duckdb/planner/operator/logical_empty_result.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_set_operation.hpp"
+
+namespace duckdb {
+
+namespace {
+
+//! A column of the delta scan, by the name it has in the Delta log
+struct ScannedColumn {
+	string name;
+	LogicalType type;
+};
+
+} // namespace
+
+static bool ResolveColumnIndex(const LogicalGet &get, const ColumnIndex &column_index, ScannedColumn &result) {
+	if (column_index.HasChildren()) {
+		// A pushed down struct field
+		return false;
+	}
+	auto primary_index = column_index.GetPrimaryIndex();
+	if (primary_index >= get.names.size()) {
+		// A virtual column such as the row id
+		return false;
+	}
+	result.name = get.names[primary_index];
+	result.type = get.returned_types[primary_index];
+	return true;
+}
+
+//! Follows an aggregate input (optionally through a projection of plain column references) to the scanned column
+static bool ResolveScanColumn(const LogicalGet &get, optional_ptr<LogicalProjection> projection,
+                              const Expression &expr, ScannedColumn &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto binding = expr.Cast<BoundColumnRefExpression>().binding;
+	if (projection) {
+		if (binding.table_index != projection->table_index ||
+		    binding.column_index >= projection->expressions.size()) {
+			return false;
+		}
+		auto &projected = *projection->expressions[binding.column_index];
+		if (projected.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return false;
+		}
+		binding = projected.Cast<BoundColumnRefExpression>().binding;
+	}
+	if (binding.table_index != get.table_index) {
+		return false;
+	}
+	auto scan_index = binding.column_index;
+	if (!get.projection_ids.empty()) {
+		if (scan_index >= get.projection_ids.size()) {
+			return false;
+		}
+		scan_index = get.projection_ids[scan_index];
+	}
+	auto &column_ids = get.GetColumnIds();
+	if (scan_index >= column_ids.size()) {
+		return false;
+	}
+	return ResolveColumnIndex(get, column_ids[scan_index], result);
+}
+
+//! Selects the files the scan reads. Only filters on partition columns can be decided per file; any other
+//! filter depends on the rows inside the files, so the aggregate cannot be answered from the log.
+static bool SelectFiles(ClientContext &context, const LogicalGet &get, const DeltaClassicSnapshot &snapshot,
+                        vector<idx_t> &file_ids) {
+	vector<pair<ScannedColumn, reference<const TableFilter>>> filters;
+	auto &column_ids = get.GetColumnIds();
+	for (auto &entry : get.table_filters.filters) {
+		ScannedColumn column;
+		if (entry.first >= column_ids.size() || !ResolveColumnIndex(get, column_ids[entry.first], column) ||
+		    !snapshot.IsPartitionColumn(column.name)) {
+			return false;
+		}
+		filters.emplace_back(column, *entry.second);
+	}
+
+	for (idx_t file_id = 0; file_id < snapshot.files.size(); file_id++) {
+		bool selected = true;
+		for (auto &filter : filters) {
+			auto &column = filter.first;
+			Value partition_value;
+			if (!snapshot.TryGetPartitionValue(snapshot.files[file_id], column.name, column.type, partition_value)) {
+				return false;
+			}
+			BoundConstantExpression constant(partition_value);
+			auto expr = filter.second.get().ToExpression(constant);
+			Value result;
+			if (!expr || !ExpressionExecutor::TryEvaluateScalar(context, *expr, result) ||
+			    result.type().id() != LogicalTypeId::BOOLEAN) {
+				return false;
+			}
+			if (result.IsNull() || !BooleanValue::Get(result)) {
+				selected = false;
+				break;
+			}
+		}
+		if (selected) {
+			file_ids.push_back(file_id);
+		}
+	}
+	return true;
+}
+
+static bool TryComputeAggregate(const BoundAggregateExpression &aggregate, const LogicalGet &get,
+                                optional_ptr<LogicalProjection> projection, const DeltaClassicSnapshot &snapshot,
+                                const vector<idx_t> &file_ids, Value &result) {
+	if (aggregate.filter || aggregate.order_bys) {
+		return false;
+	}
+	auto &name = aggregate.function.name;
+	if (name == "count_star") {
+		idx_t count;
+		if (!snapshot.TryGetExactCount(file_ids, string(), count)) {
+			return false;
+		}
+		result = Value::BIGINT(NumericCast<int64_t>(count));
+		return result.DefaultTryCastAs(aggregate.return_type);
+	}
+
+	if (aggregate.children.size() != 1) {
+		return false;
+	}
+	ScannedColumn column;
+	if (!ResolveScanColumn(get, projection, *aggregate.children[0], column)) {
+		return false;
+	}
+	if (name == "count" && !aggregate.IsDistinct()) {
+		idx_t count;
+		if (!snapshot.TryGetExactCount(file_ids, column.name, count)) {
+			return false;
+		}
+		result = Value::BIGINT(NumericCast<int64_t>(count));
+	} else if (name == "min" || name == "max") {
+		Value min;
+		Value max;
+		if (!snapshot.TryGetExactMinMax(file_ids, column.name, column.type, min, max)) {
+			return false;
+		}
+		result = name == "min" ? min : max;
+	} else {
+		return false;
+	}
+	return result.DefaultTryCastAs(aggregate.return_type);
+}
+
+//! Replaces an ungrouped aggregate over a delta_classic scan with a projection of constants
+static bool TryReplaceAggregate(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &op) {
+	auto &aggregate = op->Cast<LogicalAggregate>();
+	if (!aggregate.groups.empty() || aggregate.grouping_sets.size() > 1 || !aggregate.grouping_functions.empty() ||
+	    aggregate.expressions.empty()) {
+		return false;
+	}
+	auto child = aggregate.children[0].get();
+	optional_ptr<LogicalProjection> projection;
+	if (child->type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		projection = &child->Cast<LogicalProjection>();
+		child = child->children[0].get();
+	}
+	if (child->type != LogicalOperatorType::LOGICAL_GET) {
+		return false;
+	}
+	auto &get = child->Cast<LogicalGet>();
+	if (get.extra_info.sample_options) {
+		return false;
+	}
+	auto scan = DeltaClassicScanRegistry::Lookup(context, get.bind_data.get());
+	if (!scan.table) {
+		return false;
+	}
+	auto snapshot = scan.table->GetRewriteSnapshot(context, *scan.internal_table);
+	if (!snapshot || snapshot->HasColumnMapping()) {
+		return false;
+	}
+
+	vector<idx_t> file_ids;
+	if (!SelectFiles(context, get, *snapshot, file_ids)) {
+		return false;
+	}
+	vector<unique_ptr<Expression>> constants;
+	for (auto &expr : aggregate.expressions) {
+		if (expr->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE) {
+			return false;
+		}
+		Value value;
+		if (!TryComputeAggregate(expr->Cast<BoundAggregateExpression>(), get, projection, *snapshot, file_ids,
+		                         value)) {
+			return false;
+		}
+		constants.push_back(make_uniq<BoundConstantExpression>(std::move(value)));
+	}
+
+	// The projection takes over the aggregate's table index, so the operators above still find their columns
+	auto result = make_uniq<LogicalProjection>(aggregate.aggregate_index, std::move(constants));
+	result->children.push_back(make_uniq<LogicalDummyScan>(binder.GenerateTableIndex()));
+	op = std::move(result);
+	return true;
+}
+
+//! A scan of some of a table's data files with read_parquet, for files that share their partition values.
+//! Returns a projection onto all columns of the original scan, or nullptr if read_parquet cannot stand in for it.
+static unique_ptr<LogicalOperator> PlanFileScan(ClientContext &context, Binder &binder, const LogicalGet &get,
+                                                const DeltaClassicSnapshot &snapshot, const string &table_path,
+                                                const vector<reference<const DeltaClassicDataFile>> &files) {
+	vector<Value> paths;
+	for (auto &file : files) {
+		paths.push_back(Value(DeltaClassicSnapshot::GetAbsolutePath(table_path, file.get().path)));
+	}
+	auto &function_entry =
+	    Catalog::GetEntry<TableFunctionCatalogEntry>(context, SYSTEM_CATALOG, DEFAULT_SCHEMA, "read_parquet");
+	auto function =
+	    function_entry.functions.GetFunctionByArguments(context, {LogicalType::LIST(LogicalType::VARCHAR)});
+	vector<Value> inputs {Value::LIST(LogicalType::VARCHAR, std::move(paths))};
+	named_parameter_map_t named_parameters {{"union_by_name", Value::BOOLEAN(true)}};
+	vector<LogicalType> input_table_types;
+	vector<string> input_table_names;
+	TableFunctionRef ref;
+	TableFunctionBindInput bind_input(inputs, named_parameters, input_table_types, input_table_names,
+	                                  function.function_info.get(), &binder, function, ref);
+	vector<LogicalType> types;
+	vector<string> names;
+	auto bind_data = function.bind(context, bind_input, types, names);
+
+	auto table_index = binder.GenerateTableIndex();
+	auto file_get = make_uniq<LogicalGet>(table_index, function, std::move(bind_data), types, names);
+	auto &column_ids = get.GetColumnIds();
+	auto &partition_file = files[0].get();
+	vector<unique_ptr<Expression>> expressions;
+	unordered_map<idx_t, idx_t> file_columns;
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		auto primary_index = column_ids[i].GetPrimaryIndex();
+		auto &name = get.names[primary_index];
+		auto &type = get.returned_types[primary_index];
+		if (snapshot.IsPartitionColumn(name)) {
+			// Partition values are stored in the log only
+			Value partition_value;
+			if (!snapshot.TryGetPartitionValue(partition_file, name, type, partition_value)) {
+				return nullptr;
+			}
+			expressions.push_back(make_uniq<BoundConstantExpression>(std::move(partition_value)));
+			continue;
+		}
+		idx_t file_index = 0;
+		while (file_index < names.size() && !StringUtil::CIEquals(names[file_index], name)) {
+			file_index++;
+		}
+		if (file_index == names.size() || types[file_index] != type) {
+			// Filters pushed into the scan compare against the column's type in the table
+			return nullptr;
+		}
+		file_columns[i] = file_get->GetColumnIds().size();
+		file_get->AddColumnId(file_index);
+		expressions.push_back(make_uniq<BoundColumnRefExpression>(type, ColumnBinding(table_index, file_columns[i])));
+	}
+	for (auto &entry : get.table_filters.filters) {
+		auto file_column = file_columns.find(entry.first);
+		if (file_column != file_columns.end()) {
+			file_get->table_filters.PushFilter(ColumnIndex(file_column->second), entry.second->Copy());
+		}
+	}
+	auto projection = make_uniq<LogicalProjection>(binder.GenerateTableIndex(), std::move(expressions));
+	projection->children.push_back(std::move(file_get));
+	return std::move(projection);
+}
+
+//! Whether files with these partition values can hold rows passing the scan's filters on partition columns
+static bool PartitionMatchesFilters(ClientContext &context, const LogicalGet &get,
+                                    const DeltaClassicSnapshot &snapshot, const DeltaClassicDataFile &file,
+                                    bool &matches) {
+	auto &column_ids = get.GetColumnIds();
+	matches = true;
+	for (auto &entry : get.table_filters.filters) {
+		auto primary_index = column_ids[entry.first].GetPrimaryIndex();
+		auto &name = get.names[primary_index];
+		if (!snapshot.IsPartitionColumn(name)) {
+			continue;
+		}
+		Value partition_value;
+		if (!snapshot.TryGetPartitionValue(file, name, get.returned_types[primary_index], partition_value)) {
+			return false;
+		}
+		BoundConstantExpression constant(partition_value);
+		auto expr = entry.second->ToExpression(constant);
+		Value result;
+		if (!expr || !ExpressionExecutor::TryEvaluateScalar(context, *expr, result) ||
+		    result.type().id() != LogicalTypeId::BOOLEAN) {
+			return false;
+		}
+		if (result.IsNull() || !BooleanValue::Get(result)) {
+			matches = false;
+		}
+	}
+	return true;
+}
+
+//! Replaces a delta_classic scan with an equality filter on a column that has a key index with read_parquet scans of
+//! only the data files the index cannot rule out
+static bool TryUseKeyIndex(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &op) {
+	auto &get = op->Cast<LogicalGet>();
+	if (get.table_filters.filters.empty() || get.extra_info.sample_options) {
+		return false;
+	}
+	if (get.function.name == DeltaClassicCachedScan::FUNCTION_NAME) {
+		// Served from memory (CACHE_SMALL_TABLES), which beats reading even the selected files
+		return false;
+	}
+	auto scan = DeltaClassicScanRegistry::Lookup(context, get.bind_data.get());
+	if (!scan.table) {
+		return false;
+	}
+	auto &column_ids = get.GetColumnIds();
+	for (auto &column_index : column_ids) {
+		if (column_index.HasChildren() || column_index.GetPrimaryIndex() >= get.names.size()) {
+			// Struct fields and virtual columns are only provided by the delta scan
+			return false;
+		}
+	}
+	shared_ptr<DeltaClassicKeyIndex> index;
+	Value key;
+	for (auto &entry : get.table_filters.filters) {
+		auto &filter = *entry.second;
+		if (filter.filter_type != TableFilterType::CONSTANT_COMPARISON ||
+		    filter.Cast<ConstantFilter>().comparison_type != ExpressionType::COMPARE_EQUAL) {
+			continue;
+		}
+		index = scan.table->GetKeyIndex(context, get.names[column_ids[entry.first].GetPrimaryIndex()]);
+		if (index) {
+			key = filter.Cast<ConstantFilter>().constant;
+			break;
+		}
+	}
+	if (!index || !key.DefaultTryCastAs(index->type)) {
+		return false;
+	}
+	auto snapshot = scan.table->GetRewriteSnapshot(context, *scan.internal_table);
+	if (!snapshot || snapshot->HasColumnMapping()) {
+		return false;
+	}
+
+	// Group the remaining files by partition, as each group's partition values become constants
+	map<string, vector<reference<const DeltaClassicDataFile>>> partitions;
+	idx_t file_count = 0;
+	for (auto &file : snapshot->files) {
+		if (!index->MayContain(file.path, file.size, key)) {
+			continue;
+		}
+		if (file.has_deletion_vector) {
+			return false;
+		}
+		string partition_key;
+		for (auto &column : snapshot->partition_columns) {
+			auto value = file.partition_values.find(column);
+			partition_key += value == file.partition_values.end() || value->second.IsNull()
+			                     ? string(1, '\1')
+			                     : value->second.ToString() + string(1, '\0');
+		}
+		partitions[partition_key].push_back(file);
+		file_count++;
+	}
+	if (file_count == snapshot->files.size()) {
+		return false;
+	}
+
+	vector<unique_ptr<LogicalOperator>> scans;
+	try {
+		for (auto &partition : partitions) {
+			bool matches;
+			if (!PartitionMatchesFilters(context, get, *snapshot, partition.second[0].get(), matches)) {
+				return false;
+			}
+			if (!matches) {
+				continue;
+			}
+			auto file_scan = PlanFileScan(context, binder, get, *snapshot, scan.table->delta_table_path,
+			                              partition.second);
+			if (!file_scan) {
+				return false;
+			}
+			scans.push_back(std::move(file_scan));
+		}
+	} catch (std::exception &) {
+		// e.g. the parquet extension is not available: scan through the delta extension
+		return false;
+	}
+	DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: key index on '%s' selected %llu of %llu files of '%s'",
+	                                            index->column, file_count, snapshot->files.size(),
+	                                            scan.table->delta_table_path));
+	if (scans.empty()) {
+		op = make_uniq<LogicalEmptyResult>(std::move(op));
+		return true;
+	}
+
+	auto column_count = column_ids.size();
+	unique_ptr<LogicalOperator> source;
+	idx_t source_index;
+	if (scans.size() == 1) {
+		source_index = scans[0]->Cast<LogicalProjection>().table_index;
+		source = std::move(scans[0]);
+	} else {
+		source_index = binder.GenerateTableIndex();
+		source = make_uniq<LogicalSetOperation>(source_index, column_count, std::move(scans),
+		                                        LogicalOperatorType::LOGICAL_UNION, true);
+	}
+	// The projection takes over the scan's table index and its output columns, so the operators above still find
+	// their columns
+	vector<unique_ptr<Expression>> expressions;
+	for (idx_t i = 0; i < (get.projection_ids.empty() ? column_count : get.projection_ids.size()); i++) {
+		auto column = get.projection_ids.empty() ? i : get.projection_ids[i];
+		auto &type = get.returned_types[column_ids[column].GetPrimaryIndex()];
+		expressions.push_back(make_uniq<BoundColumnRefExpression>(type, ColumnBinding(source_index, column)));
+	}
+	auto result = make_uniq<LogicalProjection>(get.table_index, std::move(expressions));
+	result->children.push_back(std::move(source));
+	op = std::move(result);
+	return true;
+}
+
+static void OptimizeRecursive(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		OptimizeRecursive(context, binder, child);
+	}
+	if (op->type == LogicalOperatorType::LOGICAL_GET) {
+		TryUseKeyIndex(context, binder, op);
+	} else if (op->type == LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY) {
+		TryReplaceAggregate(context, binder, op);
+	}
+}
+
+//! Replaces references to a scan's schema_name column with the schema's name. Returns false if the expression
+//! references any other column.
+static bool SubstituteSchemaName(unique_ptr<Expression> &expr, const ColumnBinding &binding, const string &schema) {
+	if (expr->GetExpressionClass() == ExpressionClass::BOUND_COLUMN_REF) {
+		if (!(expr->Cast<BoundColumnRefExpression>().binding == binding)) {
+			return false;
+		}
+		expr = make_uniq<BoundConstantExpression>(Value(schema));
+		return true;
+	}
+	bool only_schema_name = true;
+	ExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<Expression> &child) {
+		only_schema_name = only_schema_name && SubstituteSchemaName(child, binding, schema);
+	});
+	return only_schema_name;
+}
+
+//! Whether a schema can be skipped because a filter on schema_name rejects its name
+static bool IsSchemaExcluded(ClientContext &context, const vector<reference<Expression>> &filters,
+                             const ColumnBinding &binding, const string &schema) {
+	for (auto &filter : filters) {
+		if (filter.get().IsVolatile()) {
+			continue;
+		}
+		auto expr = filter.get().Copy();
+		Value result;
+		if (!SubstituteSchemaName(expr, binding, schema) ||
+		    !ExpressionExecutor::TryEvaluateScalar(context, *expr, result)) {
+			// Not a filter on schema_name alone
+			continue;
+		}
+		if (result.IsNull() || (result.type().id() == LogicalTypeId::BOOLEAN && !BooleanValue::Get(result))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! A scan of one schema's table, projected to the columns of the union scan
+static unique_ptr<LogicalOperator> PlanMemberScan(ClientContext &context, Binder &binder, const LogicalGet &get,
+                                                  DeltaClassicTableEntry &table) {
+	unique_ptr<FunctionData> bind_data;
+	auto function = table.GetScanFunction(context, bind_data);
+	vector<LogicalType> types;
+	vector<string> names;
+	for (auto &column : table.GetColumns().Logical()) {
+		types.push_back(column.Type());
+		names.push_back(column.Name());
+	}
+	auto table_index = binder.GenerateTableIndex();
+	auto member_get = make_uniq<LogicalGet>(table_index, function, std::move(bind_data), types, names,
+	                                        table.GetVirtualColumns());
+
+	vector<unique_ptr<Expression>> expressions;
+	for (auto &column_index : get.GetColumnIds()) {
+		auto primary_index = column_index.GetPrimaryIndex();
+		auto &type = get.GetColumnType(column_index);
+		if (primary_index == DeltaClassicUnionTableEntry::SCHEMA_NAME_COLUMN) {
+			expressions.push_back(make_uniq<BoundConstantExpression>(Value(table.schema.name)));
+			continue;
+		}
+		column_t member_index;
+		if (primary_index < get.names.size()) {
+			auto &name = get.names[primary_index];
+			if (!table.GetColumns().ColumnExists(name)) {
+				// Not in this schema's table
+				expressions.push_back(make_uniq<BoundConstantExpression>(Value(type)));
+				continue;
+			}
+			member_index = table.GetColumns().GetColumn(name).Logical().index;
+		} else {
+			// A virtual column such as the row id, which each scan provides itself
+			member_index = primary_index;
+		}
+		member_get->AddColumnId(member_index);
+		auto binding = ColumnBinding(table_index, member_get->GetColumnIds().size() - 1);
+		auto &member_type = member_get->GetColumnType(member_get->GetColumnIds().back());
+		unique_ptr<Expression> expr = make_uniq<BoundColumnRefExpression>(member_type, binding);
+		expressions.push_back(BoundCastExpression::AddCastToType(context, std::move(expr), type));
+	}
+	auto projection = make_uniq<LogicalProjection>(binder.GenerateTableIndex(), std::move(expressions));
+	projection->children.push_back(std::move(member_get));
+	return std::move(projection);
+}
+
+//! Replaces the placeholder scan of an __all__ table with a UNION ALL of the scans of every schema that the filters
+//! on schema_name do not exclude. Excluded schemas are never attached.
+static void ExpandUnionScan(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &op,
+                            const vector<reference<Expression>> &filters) {
+	auto &get = op->Cast<LogicalGet>();
+	auto &union_data = get.bind_data->Cast<DeltaClassicUnionScanData>();
+	if (get.GetColumnIds().empty()) {
+		// Nothing is read (e.g. COUNT(*)): the scans below still need a column to bind to
+		get.AddColumnId(DeltaClassicUnionTableEntry::SCHEMA_NAME_COLUMN);
+	}
+
+	optional_idx schema_column;
+	auto &column_ids = get.GetColumnIds();
+	for (idx_t i = 0; i < column_ids.size(); i++) {
+		if (column_ids[i].GetPrimaryIndex() == DeltaClassicUnionTableEntry::SCHEMA_NAME_COLUMN) {
+			schema_column = i;
+		}
+	}
+	vector<reference<DeltaClassicTableEntry>> members;
+	for (auto &member : union_data.members) {
+		if (schema_column.IsValid() &&
+		    IsSchemaExcluded(context, filters, ColumnBinding(get.table_index, schema_column.GetIndex()),
+		                     member.get().schema.name)) {
+			continue;
+		}
+		members.push_back(member);
+	}
+	if (members.empty()) {
+		op = make_uniq<LogicalEmptyResult>(std::move(op));
+		return;
+	}
+
+	// Attach the remaining tables concurrently rather than one by one as their scans are planned
+	if (members.size() > 1) {
+		members[0].get().ParentCatalog().Cast<DeltaClassicCatalog>().AttachTables(members);
+	}
+	vector<unique_ptr<LogicalOperator>> scans;
+	for (auto &member : members) {
+		scans.push_back(PlanMemberScan(context, binder, get, member.get()));
+	}
+	auto column_count = column_ids.size();
+	unique_ptr<LogicalOperator> source;
+	idx_t source_index;
+	if (scans.size() == 1) {
+		source_index = scans[0]->Cast<LogicalProjection>().table_index;
+		source = std::move(scans[0]);
+	} else {
+		source_index = binder.GenerateTableIndex();
+		source = make_uniq<LogicalSetOperation>(source_index, column_count, std::move(scans),
+		                                        LogicalOperatorType::LOGICAL_UNION, true);
+	}
+
+	// The projection takes over the scan's table index, so the operators above still find their columns
+	vector<unique_ptr<Expression>> expressions;
+	for (idx_t i = 0; i < column_count; i++) {
+		expressions.push_back(
+		    make_uniq<BoundColumnRefExpression>(get.GetColumnType(column_ids[i]), ColumnBinding(source_index, i)));
+	}
+	auto result = make_uniq<LogicalProjection>(get.table_index, std::move(expressions));
+	result->children.push_back(std::move(source));
+	op = std::move(result);
+}
+
+//! Finds the __all__ scans in the plan. filters are the filter expressions that apply directly to op's output:
+//! those of a filter above it, passed down through cross products and inner joins.
+static void ExpandUnionScans(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &op,
+                             const vector<reference<Expression>> &filters) {
+	if (op->type == LogicalOperatorType::LOGICAL_GET) {
+		auto &get = op->Cast<LogicalGet>();
+		if (get.function.name == DeltaClassicUnionScanData::FUNCTION_NAME && get.bind_data) {
+			ExpandUnionScan(context, binder, op, filters);
+		}
+		return;
+	}
+	vector<reference<Expression>> child_filters;
+	if (op->type == LogicalOperatorType::LOGICAL_FILTER) {
+		child_filters = filters;
+		for (auto &expr : op->expressions) {
+			child_filters.push_back(*expr);
+		}
+	} else if (op->type == LogicalOperatorType::LOGICAL_CROSS_PRODUCT ||
+	           (op->type == LogicalOperatorType::LOGICAL_COMPARISON_JOIN &&
+	            op->Cast<LogicalComparisonJoin>().join_type == JoinType::INNER)) {
+		child_filters = filters;
+	}
+	for (auto &child : op->children) {
+		ExpandUnionScans(context, binder, child, child_filters);
+	}
+}
+
+void DeltaClassicOptimizer::PreOptimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	ExpandUnionScans(input.context, input.optimizer.binder, plan, vector<reference<Expression>>());
+}
+
+void DeltaClassicOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	OptimizeRecursive(input.context, input.optimizer.binder, plan);
+}
+
+void DeltaClassicOptimizer::Register(DBConfig &config) {
+	OptimizerExtension extension;
+	extension.pre_optimize_function = PreOptimize;
+	extension.optimize_function = Optimize;
+	OptimizerExtension::Register(config, std::move(extension));
+}
+
+} // namespace duckdb
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "duckdb/main/extension/extension_loader.hpp"
+
+namespace duckdb {
+
+//! Table functions operating on attached delta_classic databases
+class DeltaClassicFunctions {
+public:
+	static void Register(ExtensionLoader &loader);
+};
+
+} // namespace duckdb
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "duckdb/main/config.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+
+namespace duckdb {
+
+//! Answers ungrouped COUNT/MIN/MAX aggregates over delta_classic tables from the Delta log.
+//! When every aggregate can be computed exactly from per-file numRecords, null counts, min/max statistics and
+//! partition values, the aggregate and its scan are replaced by a single row of constants, so no data file is read.
+//! Only filters on partition columns are supported, since they select whole files.
+//! Scans with an equality filter on a column with a key index (delta_classic_build_index) become read_parquet scans
+//! of the data files the index does not rule out.
+//! Before the built-in optimizers run, it also expands scans of __all__ tables into a UNION ALL of one scan per
+//! schema, skipping the schemas that filters on schema_name exclude.
+class DeltaClassicOptimizer {
+public:
+	static void Register(DBConfig &config);
+
+private:
+	static void PreOptimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan);
+};
+
+} // namespace duckdb
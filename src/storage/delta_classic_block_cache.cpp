@@ -0,0 +1,160 @@
+#include "storage/delta_classic_block_cache.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/types/uuid.hpp"
+
+namespace duckdb {
+
+static constexpr const char *BLOCK_PREFIX = "block_";
+static constexpr const char *TEMP_SUFFIX = ".tmp";
+
+DeltaClassicBlockCache::DeltaClassicBlockCache(const string &directory, idx_t max_size)
+    : directory(directory), fs(FileSystem::CreateLocal()), max_size(max_size), total_size(0) {
+	if (!fs->DirectoryExists(directory)) {
+		fs->CreateDirectory(directory);
+	}
+	LoadExisting();
+}
+
+shared_ptr<DeltaClassicBlockCache> DeltaClassicBlockCache::Get(const string &directory, idx_t max_size) {
+	static mutex caches_lock;
+	static unordered_map<string, weak_ptr<DeltaClassicBlockCache>> caches;
+
+	lock_guard<mutex> guard(caches_lock);
+	auto cache = caches[directory].lock();
+	if (cache) {
+		lock_guard<mutex> cache_guard(cache->lock);
+		cache->max_size = max_size;
+		return cache;
+	}
+	cache = make_shared_ptr<DeltaClassicBlockCache>(directory, max_size);
+	caches[directory] = cache;
+	return cache;
+}
+
+string DeltaClassicBlockCache::GetFileKey(const string &path, idx_t file_size) {
+	// The size guards against a file replaced under the same name, which Delta writers never do
+	return std::to_string(CombineHash(Hash(path.c_str(), path.size()), Hash(file_size)));
+}
+
+string DeltaClassicBlockCache::GetBlockName(const string &file_key, idx_t block) const {
+	return BLOCK_PREFIX + file_key + "_" + std::to_string(block);
+}
+
+void DeltaClassicBlockCache::LoadExisting() {
+	vector<string> temp_files;
+	fs->ListFiles(directory, [&](const string &name, bool is_directory) {
+		if (is_directory || !StringUtil::StartsWith(name, BLOCK_PREFIX)) {
+			return;
+		}
+		if (StringUtil::EndsWith(name, TEMP_SUFFIX)) {
+			temp_files.push_back(name);
+			return;
+		}
+		auto handle = fs->OpenFile(fs->JoinPath(directory, name), FileFlags::FILE_FLAGS_READ);
+		auto size = NumericCast<idx_t>(handle->GetFileSize());
+		lru.emplace_back(name, size);
+		blocks[name] = std::prev(lru.end());
+		total_size += size;
+	});
+	RemoveBlockFiles(temp_files);
+	RemoveBlockFiles(EvictBlocks());
+}
+
+bool DeltaClassicBlockCache::Contains(const string &file_key, idx_t block) {
+	lock_guard<mutex> guard(lock);
+	return blocks.find(GetBlockName(file_key, block)) != blocks.end();
+}
+
+bool DeltaClassicBlockCache::Read(const string &file_key, idx_t block, idx_t offset, data_ptr_t buffer,
+                                  idx_t length) {
+	auto name = GetBlockName(file_key, block);
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = blocks.find(name);
+		if (entry == blocks.end() || offset + length > entry->second->second) {
+			return false;
+		}
+		lru.splice(lru.begin(), lru, entry->second);
+	}
+	try {
+		auto handle = fs->OpenFile(fs->JoinPath(directory, name), FileFlags::FILE_FLAGS_READ);
+		handle->Read(buffer, length, offset);
+		return true;
+	} catch (std::exception &) {
+		// Evicted meanwhile, or removed from the directory: read the data file instead, and cache it again
+		lock_guard<mutex> guard(lock);
+		auto entry = blocks.find(name);
+		if (entry != blocks.end()) {
+			total_size -= entry->second->second;
+			lru.erase(entry->second);
+			blocks.erase(entry);
+		}
+		return false;
+	}
+}
+
+void DeltaClassicBlockCache::Write(const string &file_key, idx_t block, const_data_ptr_t data, idx_t size) {
+	auto name = GetBlockName(file_key, block);
+	{
+		lock_guard<mutex> guard(lock);
+		if (size > max_size || blocks.find(name) != blocks.end()) {
+			return;
+		}
+	}
+	// Write to a unique temporary file and rename, so a concurrent reader never sees a partial block
+	auto temp_name = name + "." + UUID::ToString(UUID::GenerateRandomUUID()) + TEMP_SUFFIX;
+	try {
+		auto temp_path = fs->JoinPath(directory, temp_name);
+		{
+			auto handle =
+			    fs->OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+			handle->Write(const_cast<data_ptr_t>(data), size, 0);
+		}
+		fs->MoveFile(temp_path, fs->JoinPath(directory, name));
+	} catch (std::exception &) {
+		// The cache is an optimization - a full or unwritable disk must not fail the query
+		RemoveBlockFiles({temp_name});
+		return;
+	}
+
+	vector<string> evicted;
+	{
+		lock_guard<mutex> guard(lock);
+		if (blocks.find(name) != blocks.end()) {
+			// Another reader cached the same block meanwhile
+			return;
+		}
+		lru.emplace_front(name, size);
+		blocks[name] = lru.begin();
+		total_size += size;
+		evicted = EvictBlocks();
+	}
+	RemoveBlockFiles(evicted);
+}
+
+vector<string> DeltaClassicBlockCache::EvictBlocks() {
+	vector<string> evicted;
+	while (total_size > max_size && !lru.empty()) {
+		auto &oldest = lru.back();
+		total_size -= oldest.second;
+		blocks.erase(oldest.first);
+		evicted.push_back(oldest.first);
+		lru.pop_back();
+	}
+	return evicted;
+}
+
+void DeltaClassicBlockCache::RemoveBlockFiles(const vector<string> &names) {
+	for (auto &name : names) {
+		try {
+			fs->RemoveFile(fs->JoinPath(directory, name));
+		} catch (std::exception &) {
+			// Already removed
+		}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,365 @@
+#include "storage/delta_classic_cache_file_system.hpp"
+#include "storage/delta_classic_block_cache.hpp"
+#include "storage/delta_classic_parallel.hpp"
+#include "storage/delta_classic_stats.hpp"
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+//! Set while the cache opens a file through the virtual file system, which then skips the cache layers
+static thread_local bool bypass_cache = false;
+
+namespace {
+
+struct CacheBypass {
+	CacheBypass() : previous(bypass_cache) {
+		bypass_cache = true;
+	}
+	~CacheBypass() {
+		bypass_cache = previous;
+	}
+	bool previous;
+};
+
+class DeltaClassicCachedFileHandle : public FileHandle {
+public:
+	DeltaClassicCachedFileHandle(shared_ptr<DeltaClassicCacheFileSystem> layer_p, const string &path,
+	                             FileOpenFlags flags, unique_ptr<FileHandle> inner_p, string footer_key_p)
+	    : FileHandle(*layer_p, path, flags), layer(std::move(layer_p)), inner(std::move(inner_p)),
+	      footer_key(std::move(footer_key_p)), position(0) {
+		file_size = NumericCast<idx_t>(inner->GetFileSize());
+		file_key = DeltaClassicBlockCache::GetFileKey(path, file_size);
+	}
+
+	void Close() override {
+		inner->Close();
+	}
+
+	//! The layer serving the handle, kept alive while the handle is open even if the catalog is detached
+	shared_ptr<DeltaClassicCacheFileSystem> layer;
+	//! The handle of the file system that serves the file
+	unique_ptr<FileHandle> inner;
+	idx_t file_size;
+	string file_key;
+	string footer_key;
+	idx_t position;
+};
+
+//! The entry registered with the virtual file system: forwards opens to the shared layer, which serves the handles
+class DeltaClassicCacheSubSystem : public FileSystem {
+public:
+	explicit DeltaClassicCacheSubSystem(shared_ptr<DeltaClassicCacheFileSystem> layer_p) : layer(std::move(layer_p)) {
+	}
+
+	string GetName() const override {
+		return layer->GetName();
+	}
+	bool CanHandleFile(const string &fpath) override {
+		return layer->CanHandleFile(fpath);
+	}
+	bool FileExists(const string &filename, optional_ptr<FileOpener> opener = nullptr) override {
+		return layer->FileExists(filename, opener);
+	}
+
+protected:
+	unique_ptr<FileHandle> OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
+	                                        optional_ptr<FileOpener> opener) override {
+		return layer->OpenFileExtended(file, flags, opener);
+	}
+	bool SupportsOpenFileExtended() const override {
+		return true;
+	}
+
+private:
+	shared_ptr<DeltaClassicCacheFileSystem> layer;
+};
+
+} // namespace
+
+DeltaClassicCacheFileSystem::DeltaClassicCacheFileSystem(FileSystem &parent, string name, const string &base_path,
+                                                         shared_ptr<DeltaClassicBlockCache> cache)
+    : parent(parent), name(std::move(name)), cache(std::move(cache)), footers_size(0) {
+	prefixes.push_back(base_path + "/");
+	if (!StringUtil::Contains(base_path, "://") && !parent.IsPathAbsolute(base_path)) {
+		// The delta extension opens local data files by their absolute path
+		prefixes.push_back(parent.JoinPath(FileSystem::GetWorkingDirectory(), base_path) + "/");
+	}
+}
+
+shared_ptr<DeltaClassicCacheFileSystem>
+DeltaClassicCacheFileSystem::Register(FileSystem &fs, const string &base_path,
+                                      shared_ptr<DeltaClassicBlockCache> cache) {
+	static atomic<idx_t> next_id(0);
+	// Unique per catalog, so a catalog replacing another of the same name does not unregister its layer
+	auto name = "DeltaClassicCacheFileSystem_" + std::to_string(++next_id);
+	auto layer = make_shared_ptr<DeltaClassicCacheFileSystem>(fs, name, base_path, std::move(cache));
+	fs.RegisterSubSystem(make_uniq<DeltaClassicCacheSubSystem>(layer));
+	return layer;
+}
+
+void DeltaClassicCacheFileSystem::Unregister(FileSystem &fs, const string &name) {
+	fs.ExtractSubSystem(name);
+}
+
+string DeltaClassicCacheFileSystem::GetName() const {
+	return name;
+}
+
+static string StripFileScheme(const string &path) {
+	return StringUtil::StartsWith(path, "file://") ? path.substr(7) : path;
+}
+
+bool DeltaClassicCacheFileSystem::CanHandleFile(const string &fpath) {
+	if (bypass_cache) {
+		return false;
+	}
+	auto path = StripFileScheme(fpath);
+	if (!StringUtil::EndsWith(StringUtil::Lower(path), ".parquet") || StringUtil::Contains(path, "/_delta_log/")) {
+		return false;
+	}
+	for (auto &prefix : prefixes) {
+		if (StringUtil::StartsWith(path, prefix)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DeltaClassicCacheFileSystem::FileExists(const string &filename, optional_ptr<FileOpener> opener) {
+	CacheBypass bypass;
+	return parent.FileExists(filename, opener);
+}
+
+unique_ptr<FileHandle> DeltaClassicCacheFileSystem::OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
+                                                                     optional_ptr<FileOpener> opener) {
+	unique_ptr<FileHandle> inner;
+	{
+		CacheBypass bypass;
+		inner = parent.OpenFile(file, flags, opener);
+	}
+	if (!inner || flags.OpenForWriting()) {
+		return inner;
+	}
+	auto file_size = NumericCast<idx_t>(inner->GetFileSize());
+	return make_uniq<DeltaClassicCachedFileHandle>(shared_from_this(), file.path, flags, std::move(inner),
+	                                               GetFooterKey(file.path, file_size));
+}
+
+string DeltaClassicCacheFileSystem::GetFooterKey(const string &path, idx_t file_size) const {
+	auto relative_path = StripFileScheme(path);
+	for (auto &prefix : prefixes) {
+		if (StringUtil::StartsWith(relative_path, prefix)) {
+			relative_path = relative_path.substr(prefix.size());
+			break;
+		}
+	}
+	return relative_path + "@" + std::to_string(file_size);
+}
+
+idx_t DeltaClassicCacheFileSystem::PrefetchFooters(const vector<string> &paths, idx_t max_threads) {
+	atomic<idx_t> cached(0);
+	DeltaClassicParallel::ForEach(paths.size(), max_threads, [&](idx_t i) {
+		try {
+			if (PrefetchFooter(paths[i])) {
+				cached++;
+			}
+		} catch (std::exception &) {
+			// The scan reads the footer itself
+		}
+	});
+	return cached;
+}
+
+bool DeltaClassicCacheFileSystem::PrefetchFooter(const string &path) {
+	// Parquet files end with the footer, its 4-byte length and the "PAR1" magic. One read of the tail usually
+	// covers the whole footer; a larger one is read again.
+	static constexpr idx_t TAIL_SIZE = 64 * 1024;
+	unique_ptr<FileHandle> handle;
+	{
+		CacheBypass bypass;
+		handle = parent.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	}
+	auto file_size = NumericCast<idx_t>(handle->GetFileSize());
+	auto key = GetFooterKey(path, file_size);
+	{
+		lock_guard<mutex> guard(footers_lock);
+		if (footers.find(key) != footers.end()) {
+			return true;
+		}
+	}
+	if (file_size < 12) {
+		return false;
+	}
+	CachedFooter footer;
+	auto tail_size = MinValue<idx_t>(TAIL_SIZE, file_size);
+	footer.offset = file_size - tail_size;
+	footer.data.resize(tail_size);
+	handle->Read((void *)footer.data.data(), tail_size, footer.offset);
+	stats.storage_read_bytes += tail_size;
+	if (footer.data.compare(tail_size - 4, 4, "PAR1") != 0) {
+		return false;
+	}
+	auto footer_size = idx_t(Load<uint32_t>(const_data_ptr_cast(footer.data.data() + tail_size - 8))) + 8;
+	if (footer_size > file_size) {
+		return false;
+	}
+	if (footer_size > tail_size) {
+		footer.offset = file_size - footer_size;
+		footer.data.resize(footer_size);
+		handle->Read((void *)footer.data.data(), footer_size, footer.offset);
+		stats.storage_read_bytes += footer_size;
+	}
+
+	lock_guard<mutex> guard(footers_lock);
+	if (footers.find(key) != footers.end()) {
+		// Prefetched meanwhile by a concurrent attach of the same table
+		return true;
+	}
+	if (footer.data.size() > FOOTER_CACHE_SIZE) {
+		return false;
+	}
+	footers_size += footer.data.size();
+	footers.emplace(key, std::move(footer));
+	footer_order.push_back(key);
+	while (footers_size > FOOTER_CACHE_SIZE) {
+		auto oldest = footers.find(footer_order.front());
+		footers_size -= oldest->second.data.size();
+		footers.erase(oldest);
+		footer_order.pop_front();
+	}
+	return true;
+}
+
+bool DeltaClassicCacheFileSystem::ReadFooter(const string &footer_key, data_ptr_t buffer, idx_t length,
+                                             idx_t location) {
+	lock_guard<mutex> guard(footers_lock);
+	auto entry = footers.find(footer_key);
+	if (entry == footers.end()) {
+		return false;
+	}
+	auto &footer = entry->second;
+	if (location < footer.offset || location + length > footer.offset + footer.data.size()) {
+		return false;
+	}
+	memcpy(buffer, footer.data.data() + (location - footer.offset), length);
+	return true;
+}
+
+bool DeltaClassicCacheFileSystem::SupportsOpenFileExtended() const {
+	return true;
+}
+
+void DeltaClassicCacheFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto &cached = handle.Cast<DeltaClassicCachedFileHandle>();
+	auto block_size = DeltaClassicBlockCache::BLOCK_SIZE;
+	auto out = static_cast<data_ptr_t>(buffer);
+	auto end = location + NumericCast<idx_t>(nr_bytes);
+	if (ReadFooter(cached.footer_key, out, end - location, location)) {
+		stats.cache_read_bytes += end - location;
+		return;
+	}
+	if (!cache) {
+		cached.inner->Read(buffer, nr_bytes, location);
+		stats.storage_read_bytes += end - location;
+		return;
+	}
+	auto position = location;
+	while (position < end) {
+		auto block = position / block_size;
+		auto block_end = MinValue<idx_t>((block + 1) * block_size, end);
+		if (cache->Read(cached.file_key, block, position - block * block_size, out + (position - location),
+		                block_end - position)) {
+			stats.cache_read_bytes += block_end - position;
+			position = block_end;
+			continue;
+		}
+		// Fetch the run of uncached blocks the read covers with one request, in whole blocks so they can be
+		// cached. Only the part of the last block up to the end of the file exists.
+		auto last_block = (end - 1) / block_size;
+		auto run_end = block + 1;
+		while (run_end <= last_block && !cache->Contains(cached.file_key, run_end)) {
+			run_end++;
+		}
+		auto fetch_start = block * block_size;
+		auto fetch_end = MinValue<idx_t>(run_end * block_size, cached.file_size);
+		if (fetch_end < MinValue<idx_t>(run_end * block_size, end)) {
+			// Past the end of the file: let the file system report it
+			cached.inner->Read(out + (position - location), end - position, position);
+			stats.storage_read_bytes += end - position;
+			return;
+		}
+		auto data = make_unsafe_uniq_array<data_t>(fetch_end - fetch_start);
+		cached.inner->Read(data.get(), fetch_end - fetch_start, fetch_start);
+		stats.storage_read_bytes += fetch_end - fetch_start;
+		for (auto fetched = block; fetched < run_end; fetched++) {
+			auto offset = (fetched - block) * block_size;
+			auto size = MinValue<idx_t>(block_size, fetch_end - fetch_start - offset);
+			cache->Write(cached.file_key, fetched, data.get() + offset, size);
+		}
+		auto copy_end = MinValue<idx_t>(run_end * block_size, end);
+		memcpy(out + (position - location), data.get() + (position - fetch_start), copy_end - position);
+		position = copy_end;
+	}
+}
+
+int64_t DeltaClassicCacheFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
+	auto &cached = handle.Cast<DeltaClassicCachedFileHandle>();
+	auto remaining = cached.file_size - MinValue<idx_t>(cached.position, cached.file_size);
+	auto read = MinValue<idx_t>(NumericCast<idx_t>(nr_bytes), remaining);
+	Read(handle, buffer, NumericCast<int64_t>(read), cached.position);
+	cached.position += read;
+	return NumericCast<int64_t>(read);
+}
+
+int64_t DeltaClassicCacheFileSystem::GetFileSize(FileHandle &handle) {
+	return NumericCast<int64_t>(handle.Cast<DeltaClassicCachedFileHandle>().file_size);
+}
+
+timestamp_t DeltaClassicCacheFileSystem::GetLastModifiedTime(FileHandle &handle) {
+	auto &inner = *handle.Cast<DeltaClassicCachedFileHandle>().inner;
+	return inner.file_system.GetLastModifiedTime(inner);
+}
+
+string DeltaClassicCacheFileSystem::GetVersionTag(FileHandle &handle) {
+	auto &inner = *handle.Cast<DeltaClassicCachedFileHandle>().inner;
+	return inner.file_system.GetVersionTag(inner);
+}
+
+void DeltaClassicCacheFileSystem::Seek(FileHandle &handle, idx_t location) {
+	handle.Cast<DeltaClassicCachedFileHandle>().position = location;
+}
+
+void DeltaClassicCacheFileSystem::Reset(FileHandle &handle) {
+	handle.Cast<DeltaClassicCachedFileHandle>().position = 0;
+}
+
+idx_t DeltaClassicCacheFileSystem::SeekPosition(FileHandle &handle) {
+	return handle.Cast<DeltaClassicCachedFileHandle>().position;
+}
+
+bool DeltaClassicCacheFileSystem::CanSeek() {
+	return true;
+}
+
+bool DeltaClassicCacheFileSystem::OnDiskFile(FileHandle &handle) {
+	// Readers plan local-disk access (no read-ahead buffering of whole ranges) only for files the block cache
+	// serves completely; anything else is still fetched through the file system of the file
+	auto &cached = handle.Cast<DeltaClassicCachedFileHandle>();
+	if (cache) {
+		auto block_size = DeltaClassicBlockCache::BLOCK_SIZE;
+		auto block_count = (cached.file_size + block_size - 1) / block_size;
+		bool fully_cached = true;
+		for (idx_t block = 0; fully_cached && block < block_count; block++) {
+			fully_cached = cache->Contains(cached.file_key, block);
+		}
+		if (fully_cached) {
+			return true;
+		}
+	}
+	auto &inner = *cached.inner;
+	return inner.file_system.OnDiskFile(inner);
+}
+
+} // namespace duckdb
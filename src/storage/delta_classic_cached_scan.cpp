@@ -0,0 +1,97 @@
+#include "storage/delta_classic_cached_scan.hpp"
+
+#include "duckdb/storage/statistics/node_statistics.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct DeltaClassicCachedScanData : public TableFunctionData {
+	explicit DeltaClassicCachedScanData(shared_ptr<ColumnDataCollection> collection_p)
+	    : collection(std::move(collection_p)) {
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<DeltaClassicCachedScanData>(collection);
+	}
+	bool Equals(const FunctionData &other) const override {
+		return collection == other.Cast<DeltaClassicCachedScanData>().collection;
+	}
+
+	//! Shared with the table entry; kept alive by the scan if the entry switches to another version meanwhile
+	shared_ptr<ColumnDataCollection> collection;
+};
+
+struct DeltaClassicCachedScanState : public GlobalTableFunctionState {
+	ColumnDataScanState scan_state;
+	DataChunk scan_chunk;
+	//! For each output column, its index in scan_chunk, or INVALID_INDEX for a virtual column
+	vector<idx_t> output_columns;
+	vector<column_t> column_ids;
+	idx_t row_offset = 0;
+};
+
+} // namespace
+
+static unique_ptr<GlobalTableFunctionState> CachedScanInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &data = input.bind_data->Cast<DeltaClassicCachedScanData>();
+	auto result = make_uniq<DeltaClassicCachedScanState>();
+	vector<column_t> scan_columns;
+	for (auto &column_id : input.column_ids) {
+		if (column_id >= data.collection->ColumnCount()) {
+			result->output_columns.push_back(DConstants::INVALID_INDEX);
+		} else {
+			result->output_columns.push_back(scan_columns.size());
+			scan_columns.push_back(column_id);
+		}
+	}
+	result->column_ids = input.column_ids;
+	if (scan_columns.empty()) {
+		// Only the row count is needed
+		scan_columns.push_back(0);
+	}
+	data.collection->InitializeScan(result->scan_state, std::move(scan_columns));
+	data.collection->InitializeScanChunk(result->scan_state, result->scan_chunk);
+	return std::move(result);
+}
+
+static void CachedScanFunction(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+	auto &data = input.bind_data->Cast<DeltaClassicCachedScanData>();
+	auto &state = input.global_state->Cast<DeltaClassicCachedScanState>();
+	state.scan_chunk.Reset();
+	if (!data.collection->Scan(state.scan_state, state.scan_chunk)) {
+		return;
+	}
+	auto count = state.scan_chunk.size();
+	for (idx_t i = 0; i < state.output_columns.size(); i++) {
+		auto scan_index = state.output_columns[i];
+		if (scan_index != DConstants::INVALID_INDEX) {
+			output.data[i].Reference(state.scan_chunk.data[scan_index]);
+		} else if (state.column_ids[i] == COLUMN_IDENTIFIER_ROW_ID) {
+			output.data[i].Sequence(NumericCast<int64_t>(state.row_offset), 1, count);
+		} else {
+			output.data[i].SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(output.data[i], true);
+		}
+	}
+	output.SetCardinality(count);
+	state.row_offset += count;
+}
+
+static unique_ptr<NodeStatistics> CachedScanCardinality(ClientContext &context, const FunctionData *bind_data) {
+	auto &data = bind_data->Cast<DeltaClassicCachedScanData>();
+	return make_uniq<NodeStatistics>(data.collection->Count(), data.collection->Count());
+}
+
+TableFunction DeltaClassicCachedScan::GetFunction() {
+	TableFunction function(FUNCTION_NAME, {}, CachedScanFunction, nullptr, CachedScanInit);
+	function.projection_pushdown = true;
+	function.cardinality = CachedScanCardinality;
+	return function;
+}
+
+unique_ptr<FunctionData> DeltaClassicCachedScan::Bind(shared_ptr<ColumnDataCollection> collection) {
+	return make_uniq<DeltaClassicCachedScanData>(std::move(collection));
+}
+
+} // namespace duckdb
@@ -1,26 +1,68 @@
 #include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_block_cache.hpp"
+#include "storage/delta_classic_cache_file_system.hpp"
 #include "storage/delta_classic_schema_entry.hpp"
+#include "storage/delta_classic_snapshot_registry.hpp"
+#include "storage/delta_classic_stats.hpp"
+#include "storage/delta_classic_discovery.hpp"
+#include "storage/delta_classic_manifest.hpp"
+#include "storage/delta_classic_parallel.hpp"
+#include "storage/delta_classic_replica.hpp"
+#include "storage/delta_classic_table_entry.hpp"
+#include "storage/delta_classic_union_entry.hpp"
 
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/exception/binder_exception.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/logging/logger.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "duckdb/parser/parsed_data/drop_info.hpp"
 #include "duckdb/storage/database_size.hpp"
 #include "duckdb/main/database_manager.hpp"
 
+#include <algorithm>
+
 namespace duckdb {
 
 DeltaClassicCatalog::DeltaClassicCatalog(AttachedDatabase &db, const string &base_path, AccessMode access_mode,
-                                         bool pin_snapshot)
-    : Catalog(db), base_path(base_path), access_mode(access_mode), pin_snapshot(pin_snapshot), schemas_loaded(false) {
+                                         DeltaClassicOptions options, DeltaClassicSnapshotRegistry &snapshots)
+    : Catalog(db), base_path(base_path), access_mode(access_mode), options(std::move(options)),
+      path_filter(this->options.include_patterns, this->options.exclude_patterns), snapshots(snapshots),
+      schemas_loaded(false),
+      stop_background_work(false), use_clock(0) {
 }
 
-DeltaClassicCatalog::~DeltaClassicCatalog() = default;
+DeltaClassicCatalog::~DeltaClassicCatalog() {
+	StopBackgroundWork();
+}
 
 void DeltaClassicCatalog::Initialize(bool load_builtin) {
+	if (!options.local_cache.empty() || options.prefetch_footers) {
+		auto &fs = FileSystem::GetFileSystem(GetDatabase());
+		shared_ptr<DeltaClassicBlockCache> cache;
+		if (!options.local_cache.empty()) {
+			cache = DeltaClassicBlockCache::Get(options.local_cache, options.local_cache_size);
+		}
+		cache_file_system = DeltaClassicCacheFileSystem::Register(fs, base_path, std::move(cache));
+	}
+	if (options.prewarm) {
+		StartPrewarm();
+	}
+	if (!options.replica.empty()) {
+		replica = make_uniq<DeltaClassicReplica>(options.replica, "__dc_replica_" + GetName());
+		StartReplicaSync();
+	}
+	if (options.refresh_interval > 0) {
+		StartPeriodicRefresh();
+	}
+	if (options.max_staleness > 0) {
+		StartSnapshotRefresh();
+	}
 }
 
 string DeltaClassicCatalog::GetCatalogType() {
@@ -36,59 +78,377 @@ void DeltaClassicCatalog::DiscoverSchemas(ClientContext &context) {
 		return;
 	}
 
+	DeltaClassicTimer timer(stats, stats.discovery);
 	auto &fs = FileSystem::GetFileSystem(context);
+	bool use_cache = !options.discovery_cache.empty();
+	DeltaClassicListing listing;
+	bool from_cache = false;
+	if (use_cache) {
+		manifest_path = DeltaClassicManifest::GetPath(fs, options.discovery_cache, base_path, options);
+		try {
+			from_cache = DeltaClassicManifest::Read(fs, manifest_path, base_path, listing);
+		} catch (std::exception &) {
+			// An unreadable or corrupt manifest is a cache miss: discover again and overwrite it
+			from_cache = false;
+			listing = DeltaClassicListing();
+		}
+	}
+	if (!from_cache) {
+		// The manifest needs the complete map, so with a cache every schema is listed up front
+		DeltaClassicDiscovery discovery(fs, base_path, options, path_filter, stats);
+		listing = discovery.Discover(use_cache);
+		if (use_cache) {
+			try {
+				DeltaClassicManifest::Write(fs, manifest_path, base_path, listing);
+			} catch (std::exception &) {
+				// The cache is an optimization - an unwritable cache directory must not fail the attach
+			}
+		}
+	}
 
-	// First pass: check if any immediate child has _delta_log (single-schema mode)
-	bool has_direct_delta_tables = false;
-	vector<string> child_dirs;
+	ApplyListing(listing);
+	schemas_loaded = true;
 
-	fs.ListFiles(base_path, [&](const string &filename, bool is_directory) {
-		if (!is_directory) {
-			return;
+	if (from_cache) {
+		StartRevalidation(std::move(listing));
+	}
+}
+
+void DeltaClassicCatalog::ApplyListing(const DeltaClassicListing &listing) {
+	for (auto &schema_info : listing.schemas) {
+		auto &schema = AddSchema(schema_info.name, schema_info.path);
+		if (!schema_info.tables_loaded) {
+			continue;
+		}
+		schema.tables.LoadListing(schema_info.tables);
+	}
+}
+
+DeltaClassicSchemaEntry &DeltaClassicCatalog::AddSchema(const string &schema_name, const string &schema_path) {
+	CreateSchemaInfo info;
+	info.schema = schema_name;
+	auto schema = make_uniq<DeltaClassicSchemaEntry>(*this, info, schema_path);
+	auto &result = *schema;
+	schemas[schema_name] = std::move(schema);
+	return result;
+}
+
+void DeltaClassicCatalog::StartRevalidation(DeltaClassicListing listing) {
+	// The attaching client may be gone by the time this runs, so use the database-level file system
+	auto &fs = FileSystem::GetFileSystem(GetDatabase());
+	revalidation_thread = std::thread([this, &fs, listing]() mutable {
+		try {
+			DeltaClassicDiscovery discovery(fs, base_path, options, path_filter, stats);
+			if (discovery.Revalidate(listing)) {
+				DeltaClassicManifest::Write(fs, manifest_path, base_path, listing);
+			}
+		} catch (std::exception &) {
+			// Leave the manifest as it is; the next attach revalidates again
 		}
-		if (filename == "_delta_log") {
-			// The base_path itself is a delta table - not a directory of tables
+	});
+}
+
+void DeltaClassicCatalog::StartPrewarm() {
+	prewarm_thread = std::thread([this]() {
+		try {
+			// Background work runs on its own connections, since the attaching client may be gone
+			Connection con(GetDatabase());
+			auto tables = ListAllTables(*con.context);
+			if (options.max_attached_tables > 0 && tables.size() > options.max_attached_tables) {
+				// Attaching more would only evict tables prewarmed a moment ago
+				tables.resize(options.max_attached_tables);
+			}
+
+			// Each table is attached under its own lock, so a query waits only for the tables it needs
+			AttachTables(tables);
+		} catch (std::exception &) {
+			// Prewarming is best effort; queries discover and attach on demand
+		}
+	});
+}
+
+vector<reference<DeltaClassicTableEntry>> DeltaClassicCatalog::ListAllTables(ClientContext &context) {
+	auto &instance = GetDatabase();
+	auto schema_entries = GetSchemas(context);
+	vector<vector<reference<DeltaClassicTableEntry>>> schema_tables(schema_entries.size());
+	DeltaClassicParallel::ForEach(schema_entries.size(), options.discovery_threads, [&](idx_t i) {
+		if (stop_background_work) {
 			return;
 		}
-		if (filename.empty() || filename[0] == '.') {
+		Connection schema_con(instance);
+		schema_tables[i] = schema_entries[i].get().tables.GetEntries(*schema_con.context);
+	});
+	vector<reference<DeltaClassicTableEntry>> tables;
+	for (auto &entries : schema_tables) {
+		tables.insert(tables.end(), entries.begin(), entries.end());
+	}
+	return tables;
+}
+
+void DeltaClassicCatalog::StartReplicaSync() {
+	replica_thread = std::thread([this]() {
+		try {
+			// Background work runs on its own connections, since the attaching client may be gone
+			Connection con(GetDatabase());
+			auto &context = *con.context;
+			context.RunFunctionInTransaction([&]() { SyncReplica(context); });
+		} catch (std::exception &) {
+			// Tables are read from Delta until a refresh copies them
+		}
+	});
+}
+
+DeltaClassicReplicaResult DeltaClassicCatalog::SyncReplica(ClientContext &context) {
+	auto tables = ListAllTables(context);
+	auto result = replica->Sync(context, tables, options.discovery_threads, stop_background_work);
+	DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: replica sync copied %llu, appended to %llu and "
+	                                            "dropped %llu tables of '%s'; %llu failed",
+	                                            result.tables_copied, result.tables_appended, result.tables_dropped,
+	                                            base_path, result.tables_failed));
+	return result;
+}
+
+vector<reference<DeltaClassicSchemaEntry>> DeltaClassicCatalog::GetSchemas(ClientContext &context) {
+	DiscoverSchemas(context);
+	return GetLoadedSchemas();
+}
+
+vector<reference<DeltaClassicSchemaEntry>> DeltaClassicCatalog::GetLoadedSchemas() {
+	vector<reference<DeltaClassicSchemaEntry>> result;
+	{
+		lock_guard<mutex> lock(schema_lock);
+		for (auto &entry : schemas) {
+			result.push_back(*entry.second);
+		}
+	}
+	std::sort(result.begin(), result.end(),
+	          [](const DeltaClassicSchemaEntry &a, const DeltaClassicSchemaEntry &b) { return a.name < b.name; });
+	return result;
+}
+
+void DeltaClassicCatalog::AttachTables(const vector<reference<DeltaClassicTableEntry>> &tables) {
+	auto &instance = GetDatabase();
+	DeltaClassicParallel::ForEach(tables.size(), options.discovery_threads, [&](idx_t i) {
+		if (stop_background_work) {
 			return;
 		}
-		string child_path = base_path + "/" + filename;
-		string delta_log_path = child_path + "/_delta_log";
-		if (fs.DirectoryExists(delta_log_path)) {
-			has_direct_delta_tables = true;
+		try {
+			Connection table_con(instance);
+			auto &table_context = *table_con.context;
+			table_context.RunFunctionInTransaction([&]() { tables[i].get().Prewarm(table_context); });
+		} catch (std::exception &) {
+			// The next bind of the table attaches it again and reports the error
 		}
-		child_dirs.push_back(filename);
 	});
+}
 
-	if (has_direct_delta_tables) {
-		// Single-schema mode: all delta tables are direct children
-		// Use DEFAULT_SCHEMA ("main") so unqualified table names work after USE db
-		string schema_name = DEFAULT_SCHEMA;
+void DeltaClassicCatalog::StartPeriodicRefresh() {
+	refresh_thread = std::thread([this]() {
+		auto interval = std::chrono::microseconds(options.refresh_interval);
+		while (true) {
+			{
+				unique_lock<mutex> lock(background_lock);
+				background_cv.wait_for(lock, interval, [this]() { return stop_background_work.load(); });
+				if (stop_background_work) {
+					return;
+				}
+			}
+			try {
+				Connection con(GetDatabase());
+				auto &context = *con.context;
+				context.RunFunctionInTransaction([&]() { Refresh(context); });
+			} catch (std::exception &) {
+				// The catalog stays as it was; the next interval tries again
+			}
+		}
+	});
+}
 
-		CreateSchemaInfo info;
-		info.schema = schema_name;
-		schemas[schema_name] = make_uniq<DeltaClassicSchemaEntry>(*this, info, base_path);
-	} else {
-		// Multi-schema mode: each child directory is a schema
-		for (auto &dir_name : child_dirs) {
-			if (dir_name.empty() || dir_name[0] == '_') {
+void DeltaClassicCatalog::ScheduleSnapshotRefresh(DeltaClassicTableEntry &table) {
+	{
+		lock_guard<mutex> lock(background_lock);
+		stale_tables.push_back(table);
+	}
+	background_cv.notify_all();
+}
+
+void DeltaClassicCatalog::StartSnapshotRefresh() {
+	snapshot_refresh_thread = std::thread([this]() {
+		// Tables whose replaced internal databases were still in use, retried until they can be detached
+		vector<reference<DeltaClassicTableEntry>> replaced;
+		auto retry_interval = std::chrono::microseconds(options.max_staleness);
+		while (true) {
+			vector<reference<DeltaClassicTableEntry>> tables;
+			{
+				unique_lock<mutex> lock(background_lock);
+				auto has_work = [this]() { return stop_background_work.load() || !stale_tables.empty(); };
+				if (replaced.empty()) {
+					background_cv.wait(lock, has_work);
+				} else {
+					background_cv.wait_for(lock, retry_interval, has_work);
+				}
+				if (stop_background_work) {
+					return;
+				}
+				tables = std::move(stale_tables);
+				stale_tables.clear();
+			}
+			try {
+				Connection con(GetDatabase());
+				auto &context = *con.context;
+				for (auto &table : tables) {
+					try {
+						context.RunFunctionInTransaction([&]() { table.get().RefreshSnapshot(context); });
+						replaced.push_back(table);
+					} catch (std::exception &) {
+						// Binds keep using the current snapshot, and schedule another refresh while it is stale
+					}
+				}
+				vector<reference<DeltaClassicTableEntry>> still_in_use;
+				for (auto &table : replaced) {
+					bool detached = false;
+					context.RunFunctionInTransaction([&]() { detached = table.get().DetachReplaced(context); });
+					if (!detached) {
+						still_in_use.push_back(table);
+					}
+				}
+				replaced = std::move(still_in_use);
+			} catch (std::exception &) {
+				// Replaced databases that could not be detached are detached with the catalog
+				replaced.clear();
+			}
+		}
+	});
+}
+
+DeltaClassicRefreshResult DeltaClassicCatalog::Refresh(ClientContext &context) {
+	auto result = RefreshListing(context);
+	if (replica) {
+		SyncReplica(context);
+	}
+	return result;
+}
+
+DeltaClassicRefreshResult DeltaClassicCatalog::RefreshListing(ClientContext &context) {
+	DeltaClassicRefreshResult result;
+	if (!schemas_loaded) {
+		// Nothing was discovered yet, so the first access lists the current state anyway
+		return result;
+	}
+	lock_guard<mutex> refresh_guard(refresh_lock);
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	bool use_cache = !options.discovery_cache.empty();
+	DeltaClassicDiscovery discovery(fs, base_path, options, path_filter, stats);
+	DeltaClassicListing listing;
+	{
+		DeltaClassicTimer timer(stats, stats.discovery);
+		listing = discovery.Discover(use_cache);
+	}
+
+	// Schemas that were listed (or had tables looked up) are listed again so their tables can be diffed.
+	// Schemas never accessed stay lazy and are listed on first access, as before.
+	vector<idx_t> relist;
+	{
+		lock_guard<mutex> lock(schema_lock);
+		for (idx_t i = 0; i < listing.schemas.size(); i++) {
+			auto &schema_info = listing.schemas[i];
+			auto it = schemas.find(schema_info.name);
+			if (!schema_info.tables_loaded && it != schemas.end() && it->second->schema_path == schema_info.path &&
+			    it->second->tables.NeedsRefresh()) {
+				relist.push_back(i);
+			}
+		}
+	}
+	DeltaClassicParallel::ForEach(relist.size(), options.discovery_threads, [&](idx_t i) {
+		auto &schema_info = listing.schemas[relist[i]];
+		schema_info.tables = discovery.ListTables(schema_info.path);
+		schema_info.tables_loaded = true;
+	});
+
+	vector<unique_ptr<DeltaClassicTableEntry>> retired_tables;
+	vector<reference<DeltaClassicTableEntry>> retired;
+	{
+		lock_guard<mutex> lock(schema_lock);
+		case_insensitive_map_t<string> listed_schemas;
+		for (auto &schema_info : listing.schemas) {
+			listed_schemas[schema_info.name] = schema_info.path;
+		}
+		for (auto it = schemas.begin(); it != schemas.end();) {
+			auto listed = listed_schemas.find(it->first);
+			if (listed != listed_schemas.end() && listed->second == it->second->schema_path) {
+				it++;
 				continue;
 			}
-			string schema_path = base_path + "/" + dir_name;
-			CreateSchemaInfo info;
-			info.schema = dir_name;
-			schemas[dir_name] = make_uniq<DeltaClassicSchemaEntry>(*this, info, schema_path);
+			it->second->tables.Refresh(vector<DeltaClassicDiscoveredTable>(), result, retired_tables);
+			retired_entries.push_back(std::move(it->second));
+			it = schemas.erase(it);
+			result.schemas_removed++;
 		}
-		// Ensure a "main" schema exists so USE db works
-		if (schemas.find(DEFAULT_SCHEMA) == schemas.end()) {
-			CreateSchemaInfo main_info;
-			main_info.schema = DEFAULT_SCHEMA;
-			schemas[DEFAULT_SCHEMA] = make_uniq<DeltaClassicSchemaEntry>(*this, main_info, base_path);
+
+		for (auto &schema_info : listing.schemas) {
+			auto it = schemas.find(schema_info.name);
+			if (it == schemas.end()) {
+				auto &schema = AddSchema(schema_info.name, schema_info.path);
+				result.schemas_added++;
+				if (schema_info.tables_loaded) {
+					schema.tables.Refresh(schema_info.tables, result, retired_tables);
+				}
+				continue;
+			}
+			if (schema_info.tables_loaded) {
+				it->second->tables.Refresh(schema_info.tables, result, retired_tables);
+			}
+		}
+		for (auto &table : retired_tables) {
+			retired.push_back(*table);
+			retired_entries.push_back(std::move(table));
 		}
 	}
+	DetachRetired(context, retired);
 
-	schemas_loaded = true;
+	if (use_cache) {
+		try {
+			DeltaClassicManifest::Write(fs, manifest_path, base_path, listing);
+		} catch (std::exception &) {
+			// The cache is an optimization - an unwritable cache directory must not fail the refresh
+		}
+	}
+	return result;
+}
+
+void DeltaClassicCatalog::DetachRetired(ClientContext &context,
+                                        const vector<reference<DeltaClassicTableEntry>> &tables) {
+	// A table still used by a running query stays attached until it is evicted or the catalog is detached
+	for (auto &table : tables) {
+		if (table.get().TryEvict(context)) {
+			lock_guard<mutex> lock(internal_db_lock);
+			attached_tables.erase(table);
+		}
+	}
+}
+
+void DeltaClassicCatalog::StopBackgroundWork() {
+	{
+		lock_guard<mutex> lock(background_lock);
+		stop_background_work = true;
+	}
+	background_cv.notify_all();
+	if (revalidation_thread.joinable()) {
+		revalidation_thread.join();
+	}
+	if (prewarm_thread.joinable()) {
+		prewarm_thread.join();
+	}
+	if (refresh_thread.joinable()) {
+		refresh_thread.join();
+	}
+	if (snapshot_refresh_thread.joinable()) {
+		snapshot_refresh_thread.join();
+	}
+	if (replica_thread.joinable()) {
+		replica_thread.join();
+	}
 }
 
 optional_ptr<CatalogEntry> DeltaClassicCatalog::CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) {
@@ -113,6 +473,14 @@ optional_ptr<SchemaCatalogEntry> DeltaClassicCatalog::LookupSchema(CatalogTransa
 	auto &schema_name = schema_lookup.GetEntryName();
 
 	lock_guard<mutex> lock(schema_lock);
+	if (schema_name == DELTA_CLASSIC_UNION_SCHEMA) {
+		if (!union_schema) {
+			CreateSchemaInfo info;
+			info.schema = schema_name;
+			union_schema = make_uniq<DeltaClassicUnionSchemaEntry>(*this, info);
+		}
+		return union_schema.get();
+	}
 
 	// Try exact match
 	auto it = schemas.find(schema_name);
@@ -182,18 +550,122 @@ void DeltaClassicCatalog::DropSchema(ClientContext &context, DropInfo &info) {
 	throw NotImplementedException("delta_classic databases are read-only");
 }
 
-void DeltaClassicCatalog::RegisterInternalDb(const string &name) {
-	lock_guard<mutex> lock(internal_db_lock);
-	internal_db_names.push_back(name);
+void DeltaClassicCatalog::OnTableAttached(ClientContext &context, DeltaClassicTableEntry &table) {
+	vector<reference<DeltaClassicTableEntry>> candidates;
+	idx_t excess;
+	{
+		lock_guard<mutex> lock(internal_db_lock);
+		attached_tables.insert(table);
+		if (options.max_attached_tables == 0 || attached_tables.size() <= options.max_attached_tables) {
+			return;
+		}
+		excess = attached_tables.size() - options.max_attached_tables;
+		for (auto &entry : attached_tables) {
+			if (&entry.get() != &table) {
+				candidates.push_back(entry);
+			}
+		}
+	}
+
+	// Tables used by running queries are skipped, so the budget may be exceeded until they finish
+	std::sort(candidates.begin(), candidates.end(),
+	          [](const reference<DeltaClassicTableEntry> &a, const reference<DeltaClassicTableEntry> &b) {
+		          return a.get().GetLastUsed() < b.get().GetLastUsed();
+	          });
+	for (auto &candidate : candidates) {
+		if (excess == 0) {
+			break;
+		}
+		if (candidate.get().TryEvict(context)) {
+			lock_guard<mutex> lock(internal_db_lock);
+			attached_tables.erase(candidate);
+			excess--;
+		}
+	}
+}
+
+idx_t DeltaClassicCatalog::NextUseTick() {
+	return ++use_clock;
+}
+
+void DeltaClassicCatalog::KeepMaterialized(DeltaClassicTableEntry &table, shared_ptr<ColumnDataCollection> collection,
+                                           int64_t version) {
+	lock_guard<mutex> lock(materialized_lock);
+	auto size = collection->AllocationSize();
+	table.SetMaterialized(std::move(collection), version);
+	// Replaces the size of the table's copy of an earlier version, if any
+	auto entry = materialized_tables.find(table);
+	if (entry != materialized_tables.end()) {
+		materialized_size -= entry->second;
+		entry->second = size;
+	} else {
+		materialized_tables.emplace(table, size);
+	}
+	materialized_size += size;
+
+	// Queries already bound to a dropped copy keep it until they finish
+	while (materialized_size > options.cache_small_tables_size) {
+		auto oldest = materialized_tables.begin();
+		for (auto it = materialized_tables.begin(); it != materialized_tables.end(); it++) {
+			if (it->first.get().GetMaterializedLastUsed() < oldest->first.get().GetMaterializedLastUsed()) {
+				oldest = it;
+			}
+		}
+		oldest->first.get().SetMaterialized(nullptr, -1);
+		materialized_size -= oldest->second;
+		materialized_tables.erase(oldest);
+	}
+}
+
+void DeltaClassicCatalog::DropMaterialized(DeltaClassicTableEntry &table) {
+	lock_guard<mutex> lock(materialized_lock);
+	table.SetMaterialized(nullptr, -1);
+	auto entry = materialized_tables.find(table);
+	if (entry != materialized_tables.end()) {
+		materialized_size -= entry->second;
+		materialized_tables.erase(entry);
+	}
 }
 
 void DeltaClassicCatalog::OnDetach(ClientContext &context) {
-	lock_guard<mutex> lock(internal_db_lock);
-	auto &db_manager = DatabaseManager::Get(context);
-	for (auto &name : internal_db_names) {
-		db_manager.DetachDatabase(context, name, OnEntryNotFound::RETURN_NULL);
+	StopBackgroundWork();
+
+	vector<reference<DeltaClassicTableEntry>> tables;
+	{
+		lock_guard<mutex> lock(internal_db_lock);
+		tables.assign(attached_tables.begin(), attached_tables.end());
+		attached_tables.clear();
+	}
+	// Internal databases shared with other catalogs stay attached until the last of them is detached. Tables are
+	// detached concurrently, each on a connection of its own, as detaching thousands of them one by one stalls the
+	// session.
+	auto &instance = GetDatabase();
+	atomic<idx_t> handed_off(0);
+	DeltaClassicParallel::ForEach(tables.size(), options.discovery_threads, [&](idx_t i) {
+		try {
+			Connection table_con(instance);
+			auto &table_context = *table_con.context;
+			table_context.RunFunctionInTransaction([&]() {
+				if (tables[i].get().DetachInternalDatabases(table_context)) {
+					handed_off++;
+				}
+			});
+		} catch (std::exception &) {
+			// Keep detaching the other tables; a database that failed to detach goes with the database instance
+		}
+	});
+	snapshots.ExpireHandOffs(context);
+	DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: detached %llu tables of '%s', handed off %llu",
+	                                            tables.size(), base_path, handed_off.load()));
+	if (replica) {
+		replica->Detach(context);
+	}
+	if (cache_file_system) {
+		// Handles opened through the layer (other connections, handed-off or shared internal databases) keep it
+		// alive until they are closed
+		DeltaClassicCacheFileSystem::Unregister(FileSystem::GetFileSystem(context), cache_file_system->GetName());
+		cache_file_system.reset();
 	}
-	internal_db_names.clear();
 }
 
 } // namespace duckdb
@@ -0,0 +1,468 @@
+#include "storage/delta_classic_discovery.hpp"
+#include "storage/delta_classic_parallel.hpp"
+#include "storage/delta_classic_stats.hpp"
+
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/set.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_set.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Pattern matching
+//===--------------------------------------------------------------------===//
+static bool MatchSegment(const char *pattern, const char *str) {
+	for (; *pattern; pattern++) {
+		if (*pattern == '*') {
+			// Collapse consecutive stars and try every possible suffix
+			while (pattern[1] == '*') {
+				pattern++;
+			}
+			for (auto s = str;; s++) {
+				if (MatchSegment(pattern + 1, s)) {
+					return true;
+				}
+				if (!*s) {
+					return false;
+				}
+			}
+		}
+		if (!*str) {
+			return false;
+		}
+		if (*pattern != '?' && *pattern != *str) {
+			return false;
+		}
+		str++;
+	}
+	return !*str;
+}
+
+static bool MatchSegments(const vector<string> &pattern, idx_t p, const vector<string> &path, idx_t s) {
+	if (p == pattern.size()) {
+		return s == path.size();
+	}
+	if (pattern[p] == "**") {
+		// '**' matches zero or more whole segments
+		for (idx_t next = s; next <= path.size(); next++) {
+			if (MatchSegments(pattern, p + 1, path, next)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	if (s == path.size()) {
+		return false;
+	}
+	return MatchSegment(pattern[p].c_str(), path[s].c_str()) && MatchSegments(pattern, p + 1, path, s + 1);
+}
+
+//! Whether some path starting with the segments of prefix could match the pattern
+static bool MatchPrefix(const vector<string> &pattern, const vector<string> &prefix) {
+	for (idx_t i = 0; i < prefix.size(); i++) {
+		if (i >= pattern.size()) {
+			return false;
+		}
+		if (pattern[i] == "**") {
+			return true;
+		}
+		if (!MatchSegment(pattern[i].c_str(), prefix[i].c_str())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static vector<string> SplitPath(const string &path) {
+	vector<string> result;
+	for (auto &segment : StringUtil::Split(path, '/')) {
+		if (!segment.empty()) {
+			result.push_back(segment);
+		}
+	}
+	return result;
+}
+
+DeltaClassicPathFilter::DeltaClassicPathFilter(vector<string> include_patterns_p, vector<string> exclude_patterns_p)
+    : include_patterns(std::move(include_patterns_p)), exclude_patterns(std::move(exclude_patterns_p)) {
+}
+
+bool DeltaClassicPathFilter::Matches(const string &relative_path) const {
+	auto path = SplitPath(relative_path);
+	for (auto &pattern : exclude_patterns) {
+		if (MatchSegments(SplitPath(pattern), 0, path, 0)) {
+			return false;
+		}
+	}
+	if (include_patterns.empty()) {
+		return true;
+	}
+	for (auto &pattern : include_patterns) {
+		if (MatchSegments(SplitPath(pattern), 0, path, 0)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool DeltaClassicPathFilter::MayContain(const string &relative_dir) const {
+	auto dir = SplitPath(relative_dir);
+	for (auto &pattern : exclude_patterns) {
+		// "staging/**" excludes everything below staging, so the directory is never listed
+		auto segments = SplitPath(pattern);
+		if (segments.empty() || segments.back() != "**") {
+			continue;
+		}
+		segments.pop_back();
+		if (segments.size() > dir.size()) {
+			continue;
+		}
+		vector<string> dir_prefix(dir.begin(), dir.begin() + int64_t(segments.size()));
+		if (MatchSegments(segments, 0, dir_prefix, 0)) {
+			return false;
+		}
+	}
+	if (include_patterns.empty()) {
+		return true;
+	}
+	for (auto &pattern : include_patterns) {
+		if (MatchPrefix(SplitPath(pattern), dir)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//===--------------------------------------------------------------------===//
+// Discovery
+//===--------------------------------------------------------------------===//
+DeltaClassicDiscovery::DeltaClassicDiscovery(FileSystem &fs, const string &base_path,
+                                             const DeltaClassicOptions &options, const DeltaClassicPathFilter &filter,
+                                             DeltaClassicStats &stats)
+    : fs(fs), base_path(base_path), options(options), filter(filter), stats(stats) {
+}
+
+DeltaClassicListing DeltaClassicDiscovery::Discover(bool load_tables) {
+	auto result =
+	    options.discovery_mode == DeltaClassicDiscoveryMode::RECURSIVE ? DiscoverByGlob() : DiscoverByWalk(load_tables);
+
+	// Ensure a "main" schema exists so USE db works
+	for (auto &schema : result.schemas) {
+		if (StringUtil::CIEquals(schema.name, DEFAULT_SCHEMA)) {
+			return result;
+		}
+	}
+	DeltaClassicDiscoveredSchema main_schema;
+	main_schema.name = DEFAULT_SCHEMA;
+	main_schema.path = base_path;
+	// Either every table was found (recursive), or no direct child of base_path is a table (multi-schema walk)
+	main_schema.tables_loaded = true;
+	result.schemas.push_back(std::move(main_schema));
+	return result;
+}
+
+DeltaClassicListing DeltaClassicDiscovery::DiscoverByWalk(bool load_tables) {
+	DeltaClassicListing result;
+
+	// First pass: check if any immediate child has _delta_log (single-schema mode)
+	auto all_dirs = ListChildDirectories(fs, base_path, stats);
+	result.fingerprint = Fingerprint(all_dirs);
+	vector<string> child_dirs;
+	vector<string> child_paths;
+	for (auto &dir_name : all_dirs) {
+		if (!filter.MayContain(dir_name)) {
+			continue;
+		}
+		child_dirs.push_back(dir_name);
+		child_paths.push_back(base_path + "/" + dir_name);
+	}
+	// Probe all children concurrently - on object storage each check is a full round trip
+	auto is_table = ProbeDeltaTables(fs, child_paths, options.discovery_threads, stats);
+	bool has_direct_delta_tables = false;
+	for (auto table : is_table) {
+		has_direct_delta_tables = has_direct_delta_tables || table;
+	}
+
+	if (has_direct_delta_tables) {
+		// Single-schema mode: all delta tables are direct children
+		// Use DEFAULT_SCHEMA ("main") so unqualified table names work after USE db
+		DeltaClassicDiscoveredSchema schema;
+		schema.name = DEFAULT_SCHEMA;
+		schema.path = base_path;
+		schema.tables_loaded = true;
+		schema.fingerprint = result.fingerprint;
+		for (idx_t i = 0; i < child_dirs.size(); i++) {
+			// The probes already answered which children are tables
+			if (is_table[i] && child_dirs[i][0] != '_' && filter.Matches(child_dirs[i])) {
+				schema.tables.push_back(DeltaClassicDiscoveredTable {child_dirs[i], child_paths[i]});
+			}
+		}
+		result.schemas.push_back(std::move(schema));
+		return result;
+	}
+
+	// Multi-schema mode: each child directory is a schema
+	for (idx_t i = 0; i < child_dirs.size(); i++) {
+		if (child_dirs[i][0] == '_') {
+			continue;
+		}
+		DeltaClassicDiscoveredSchema schema;
+		schema.name = child_dirs[i];
+		schema.path = child_paths[i];
+		result.schemas.push_back(std::move(schema));
+	}
+	if (load_tables) {
+		for (auto &schema : result.schemas) {
+			auto schema_dirs = ListChildDirectories(fs, schema.path, stats);
+			schema.fingerprint = Fingerprint(schema_dirs);
+			schema.tables = ListTables(schema.path, schema_dirs);
+			schema.tables_loaded = true;
+		}
+	}
+	return result;
+}
+
+DeltaClassicListing DeltaClassicDiscovery::DiscoverByGlob() {
+	DeltaClassicListing result;
+	auto table_paths = GlobDeltaTables(fs, base_path, filter, stats);
+	result.fingerprint = Fingerprint(table_paths);
+
+	// Positions in result.schemas by schema path. Sorting does not keep a schema's tables adjacent: "region/a/b/t2"
+	// sorts between "region/a/t1" and "region/a/t3".
+	case_insensitive_map_t<idx_t> schema_index;
+	for (auto &relative_path : table_paths) {
+		// "region/tenant/orders" becomes table "orders" in schema "region/tenant"
+		string schema_name = DEFAULT_SCHEMA;
+		string schema_path = base_path;
+		string table_name = relative_path;
+		auto slash = relative_path.rfind('/');
+		if (slash != string::npos) {
+			schema_name = relative_path.substr(0, slash);
+			schema_path = base_path + "/" + schema_name;
+			table_name = relative_path.substr(slash + 1);
+		}
+		auto entry = schema_index.find(schema_name);
+		if (entry == schema_index.end()) {
+			DeltaClassicDiscoveredSchema schema;
+			schema.name = schema_name;
+			schema.path = schema_path;
+			// The glob found every table, so no schema needs to list its directory again
+			schema.tables_loaded = true;
+			entry = schema_index.emplace(schema_name, result.schemas.size()).first;
+			result.schemas.push_back(std::move(schema));
+		}
+		auto &tables = result.schemas[entry->second].tables;
+		tables.push_back(DeltaClassicDiscoveredTable {table_name, base_path + "/" + relative_path});
+	}
+	return result;
+}
+
+vector<DeltaClassicDiscoveredTable> DeltaClassicDiscovery::ListTables(const string &schema_path) {
+	return ListTables(schema_path, ListChildDirectories(fs, schema_path, stats));
+}
+
+vector<DeltaClassicDiscoveredTable> DeltaClassicDiscovery::ListTables(const string &schema_path,
+                                                                      const vector<string> &child_dirs) {
+	auto relative_prefix = RelativePath(schema_path);
+	if (!relative_prefix.empty()) {
+		relative_prefix += "/";
+	}
+
+	vector<DeltaClassicDiscoveredTable> candidates;
+	vector<string> candidate_paths;
+	for (auto &filename : child_dirs) {
+		// Skip internal directories and tables excluded by INCLUDE / EXCLUDE
+		if (filename[0] == '_' || !filter.Matches(relative_prefix + filename)) {
+			continue;
+		}
+		candidates.push_back(DeltaClassicDiscoveredTable {filename, schema_path + "/" + filename});
+		candidate_paths.push_back(candidates.back().path);
+	}
+
+	auto is_table = ProbeDeltaTables(fs, candidate_paths, options.discovery_threads, stats);
+	vector<DeltaClassicDiscoveredTable> result;
+	for (idx_t i = 0; i < candidates.size(); i++) {
+		if (is_table[i]) {
+			result.push_back(std::move(candidates[i]));
+		}
+	}
+	return result;
+}
+
+bool DeltaClassicDiscovery::ProbeTable(const string &schema_path, const string &table_name,
+                                       DeltaClassicDiscoveredTable &result) {
+	// Names that are not a single directory component could escape the schema directory
+	if (table_name.empty() || table_name[0] == '_' || table_name[0] == '.' ||
+	    table_name.find_first_of("/\\") != string::npos) {
+		return false;
+	}
+	auto relative_path = RelativePath(schema_path);
+	if (!relative_path.empty()) {
+		relative_path += "/";
+	}
+	if (!filter.Matches(relative_path + table_name)) {
+		return false;
+	}
+	auto table_path = schema_path + "/" + table_name;
+	stats.exists_calls++;
+	if (!fs.DirectoryExists(table_path + "/_delta_log")) {
+		return false;
+	}
+	result = DeltaClassicDiscoveredTable {table_name, table_path};
+	return true;
+}
+
+bool DeltaClassicDiscovery::Revalidate(DeltaClassicListing &listing) {
+	if (options.discovery_mode == DeltaClassicDiscoveryMode::RECURSIVE) {
+		// A single glob is all recursive discovery costs, so just run it again
+		auto fresh = Discover(true);
+		bool changed = fresh.fingerprint != listing.fingerprint;
+		listing = std::move(fresh);
+		return changed;
+	}
+
+	auto base_dirs = ListChildDirectories(fs, base_path, stats);
+	if (Fingerprint(base_dirs) != listing.fingerprint) {
+		// Schemas (or direct tables) were added or removed
+		listing = Discover(true);
+		return true;
+	}
+
+	bool changed = false;
+	for (auto &schema : listing.schemas) {
+		if (!schema.tables_loaded) {
+			continue;
+		}
+		vector<string> schema_dirs;
+		if (schema.path == base_path) {
+			if (schema.tables.empty()) {
+				// The main schema of a directory of schemas holds no tables
+				continue;
+			}
+			// Tables directly under base_path, whose listing the base fingerprint already matched
+			schema_dirs = base_dirs;
+		} else {
+			schema_dirs = ListChildDirectories(fs, schema.path, stats);
+			auto fingerprint = Fingerprint(schema_dirs);
+			if (fingerprint != schema.fingerprint) {
+				schema.fingerprint = fingerprint;
+				schema.tables = ListTables(schema.path, schema_dirs);
+				changed = true;
+				continue;
+			}
+		}
+		// The same directories, but one that was not a table may have gained a _delta_log since
+		if (HasNewTables(schema, schema_dirs)) {
+			schema.tables = ListTables(schema.path, schema_dirs);
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+bool DeltaClassicDiscovery::HasNewTables(const DeltaClassicDiscoveredSchema &schema, const vector<string> &child_dirs) {
+	auto relative_prefix = RelativePath(schema.path);
+	if (!relative_prefix.empty()) {
+		relative_prefix += "/";
+	}
+	unordered_set<string> table_names;
+	for (auto &table : schema.tables) {
+		table_names.insert(table.name);
+	}
+	vector<string> candidate_paths;
+	for (auto &filename : child_dirs) {
+		if (filename[0] == '_' || !filter.Matches(relative_prefix + filename) || table_names.count(filename)) {
+			continue;
+		}
+		candidate_paths.push_back(schema.path + "/" + filename);
+	}
+	for (auto is_table : ProbeDeltaTables(fs, candidate_paths, options.discovery_threads, stats)) {
+		if (is_table) {
+			return true;
+		}
+	}
+	return false;
+}
+
+string DeltaClassicDiscovery::RelativePath(const string &path) const {
+	if (path.size() <= base_path.size()) {
+		return string();
+	}
+	return path.substr(base_path.size() + 1);
+}
+
+vector<string> DeltaClassicDiscovery::ListChildDirectories(FileSystem &fs, const string &path,
+                                                           DeltaClassicStats &stats) {
+	vector<string> result;
+	stats.list_calls++;
+	fs.ListFiles(path, [&](const string &filename, bool is_directory) {
+		if (!is_directory) {
+			return;
+		}
+		if (filename.empty() || filename[0] == '.' || filename == "_delta_log") {
+			return;
+		}
+		result.push_back(filename);
+	});
+	return result;
+}
+
+vector<bool> DeltaClassicDiscovery::ProbeDeltaTables(FileSystem &fs, const vector<string> &dirs, idx_t max_threads,
+                                                     DeltaClassicStats &stats) {
+	// vector<bool> is bit-packed, so workers write to separate bytes instead
+	vector<uint8_t> is_table(dirs.size(), 0);
+	stats.exists_calls += dirs.size();
+	DeltaClassicParallel::ForEach(dirs.size(), max_threads,
+	                              [&](idx_t i) { is_table[i] = fs.DirectoryExists(dirs[i] + "/_delta_log"); });
+	return vector<bool>(is_table.begin(), is_table.end());
+}
+
+vector<string> DeltaClassicDiscovery::GlobDeltaTables(FileSystem &fs, const string &base_path,
+                                                      const DeltaClassicPathFilter &filter, DeltaClassicStats &stats) {
+	// Every Delta table has at least one JSON commit in its log, so one recursive glob finds all of them.
+	// With INCLUDE patterns the glob itself is narrowed, and object stores only list the matching prefixes.
+	vector<string> patterns = filter.IncludePatterns();
+	if (patterns.empty()) {
+		patterns.push_back("**");
+	}
+
+	auto prefix = base_path + "/";
+	set<string> tables;
+	for (auto &pattern : patterns) {
+		stats.list_calls++;
+		for (auto &file : fs.Glob(prefix + pattern + "/_delta_log/*.json")) {
+			auto &path = file.path;
+			if (!StringUtil::StartsWith(path, prefix)) {
+				continue;
+			}
+			auto log_pos = path.find("/_delta_log/", prefix.size() - 1);
+			if (log_pos == string::npos || log_pos < prefix.size()) {
+				// The attached directory itself is a table, not a directory of tables
+				continue;
+			}
+			auto relative_path = path.substr(prefix.size(), log_pos - prefix.size());
+			bool is_hidden = false;
+			for (auto &segment : SplitPath(relative_path)) {
+				is_hidden = is_hidden || segment[0] == '.' || segment[0] == '_';
+			}
+			if (is_hidden || !filter.Matches(relative_path)) {
+				continue;
+			}
+			tables.insert(relative_path);
+		}
+	}
+	return vector<string>(tables.begin(), tables.end());
+}
+
+hash_t DeltaClassicDiscovery::Fingerprint(const vector<string> &names) {
+	// XOR keeps the fingerprint independent of listing order
+	hash_t result = Hash(uint64_t(names.size()));
+	for (auto &name : names) {
+		result ^= Hash(name.c_str(), name.size());
+	}
+	return result;
+}
+
+} // namespace duckdb
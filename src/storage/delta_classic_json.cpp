@@ -0,0 +1,248 @@
+#include "storage/delta_classic_json.hpp"
+
+#include "duckdb/common/exception.hpp"
+
+#include <cctype>
+#include <cstring>
+
+namespace duckdb {
+
+namespace {
+
+class JsonParser {
+public:
+	explicit JsonParser(const string &text) : text(text), pos(0) {
+	}
+
+	unique_ptr<DeltaClassicJsonValue> ParseDocument() {
+		auto result = ParseValue();
+		SkipWhitespace();
+		if (pos != text.size()) {
+			Error("trailing characters");
+		}
+		return result;
+	}
+
+private:
+	unique_ptr<DeltaClassicJsonValue> ParseValue() {
+		SkipWhitespace();
+		if (pos >= text.size()) {
+			Error("unexpected end of input");
+		}
+		auto result = make_uniq<DeltaClassicJsonValue>();
+		auto c = text[pos];
+		if (c == '{') {
+			result->type = DeltaClassicJsonType::OBJECT;
+			pos++;
+			SkipWhitespace();
+			if (Consume('}')) {
+				return result;
+			}
+			do {
+				SkipWhitespace();
+				result->keys.push_back(ParseString());
+				SkipWhitespace();
+				Expect(':');
+				result->children.push_back(ParseValue());
+				SkipWhitespace();
+			} while (Consume(','));
+			Expect('}');
+		} else if (c == '[') {
+			result->type = DeltaClassicJsonType::ARRAY;
+			pos++;
+			SkipWhitespace();
+			if (Consume(']')) {
+				return result;
+			}
+			do {
+				result->children.push_back(ParseValue());
+				SkipWhitespace();
+			} while (Consume(','));
+			Expect(']');
+		} else if (c == '"') {
+			result->type = DeltaClassicJsonType::STRING;
+			result->str = ParseString();
+		} else if (ConsumeLiteral("true")) {
+			result->type = DeltaClassicJsonType::BOOLEAN;
+			result->str = "true";
+		} else if (ConsumeLiteral("false")) {
+			result->type = DeltaClassicJsonType::BOOLEAN;
+			result->str = "false";
+		} else if (ConsumeLiteral("null")) {
+			result->type = DeltaClassicJsonType::JSON_NULL;
+		} else if (c == '-' || (c >= '0' && c <= '9')) {
+			result->type = DeltaClassicJsonType::NUMBER;
+			auto start = pos;
+			while (pos < text.size() && (isdigit(text[pos]) || text[pos] == '-' || text[pos] == '+' ||
+			                             text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E')) {
+				pos++;
+			}
+			result->str = text.substr(start, pos - start);
+		} else {
+			Error("unexpected character");
+		}
+		return result;
+	}
+
+	string ParseString() {
+		Expect('"');
+		string result;
+		while (pos < text.size() && text[pos] != '"') {
+			auto c = text[pos++];
+			if (c != '\\') {
+				result += c;
+				continue;
+			}
+			if (pos >= text.size()) {
+				break;
+			}
+			c = text[pos++];
+			switch (c) {
+			case 'b':
+				result += '\b';
+				break;
+			case 'f':
+				result += '\f';
+				break;
+			case 'n':
+				result += '\n';
+				break;
+			case 'r':
+				result += '\r';
+				break;
+			case 't':
+				result += '\t';
+				break;
+			case 'u':
+				AppendCodepoint(result, ParseHex4());
+				break;
+			default:
+				// '"', '\\' and '/'
+				result += c;
+				break;
+			}
+		}
+		Expect('"');
+		return result;
+	}
+
+	uint32_t ParseHex4() {
+		if (pos + 4 > text.size()) {
+			Error("truncated unicode escape");
+		}
+		uint32_t result = 0;
+		for (idx_t i = 0; i < 4; i++) {
+			auto c = text[pos++];
+			result <<= 4;
+			if (c >= '0' && c <= '9') {
+				result |= uint32_t(c - '0');
+			} else if (c >= 'a' && c <= 'f') {
+				result |= uint32_t(c - 'a' + 10);
+			} else if (c >= 'A' && c <= 'F') {
+				result |= uint32_t(c - 'A' + 10);
+			} else {
+				Error("invalid unicode escape");
+			}
+		}
+		return result;
+	}
+
+	void AppendCodepoint(string &result, uint32_t codepoint) {
+		// Combine UTF-16 surrogate pairs
+		if (codepoint >= 0xD800 && codepoint <= 0xDBFF && pos + 6 <= text.size() && text[pos] == '\\' &&
+		    text[pos + 1] == 'u') {
+			pos += 2;
+			auto low = ParseHex4();
+			codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+		}
+		if (codepoint < 0x80) {
+			result += char(codepoint);
+		} else if (codepoint < 0x800) {
+			result += char(0xC0 | (codepoint >> 6));
+			result += char(0x80 | (codepoint & 0x3F));
+		} else if (codepoint < 0x10000) {
+			result += char(0xE0 | (codepoint >> 12));
+			result += char(0x80 | ((codepoint >> 6) & 0x3F));
+			result += char(0x80 | (codepoint & 0x3F));
+		} else {
+			result += char(0xF0 | (codepoint >> 18));
+			result += char(0x80 | ((codepoint >> 12) & 0x3F));
+			result += char(0x80 | ((codepoint >> 6) & 0x3F));
+			result += char(0x80 | (codepoint & 0x3F));
+		}
+	}
+
+	void SkipWhitespace() {
+		while (pos < text.size() && isspace(text[pos])) {
+			pos++;
+		}
+	}
+
+	bool Consume(char c) {
+		if (pos < text.size() && text[pos] == c) {
+			pos++;
+			return true;
+		}
+		return false;
+	}
+
+	bool ConsumeLiteral(const char *literal) {
+		auto len = strlen(literal);
+		if (text.compare(pos, len, literal) == 0) {
+			pos += len;
+			return true;
+		}
+		return false;
+	}
+
+	void Expect(char c) {
+		if (!Consume(c)) {
+			Error(string("expected '") + c + "'");
+		}
+	}
+
+	[[noreturn]] void Error(const string &message) {
+		throw IOException("Malformed JSON in Delta log at offset %llu: %s", pos, message);
+	}
+
+private:
+	const string &text;
+	idx_t pos;
+};
+
+} // namespace
+
+unique_ptr<DeltaClassicJsonValue> DeltaClassicJsonValue::Parse(const string &text) {
+	JsonParser parser(text);
+	return parser.ParseDocument();
+}
+
+optional_ptr<const DeltaClassicJsonValue> DeltaClassicJsonValue::Get(const string &key) const {
+	if (type != DeltaClassicJsonType::OBJECT) {
+		return nullptr;
+	}
+	for (idx_t i = 0; i < keys.size(); i++) {
+		if (keys[i] == key) {
+			return children[i].get();
+		}
+	}
+	return nullptr;
+}
+
+string DeltaClassicJsonValue::GetString(const string &key) const {
+	auto value = Get(key);
+	if (!value || value->IsNull()) {
+		return string();
+	}
+	return value->str;
+}
+
+int64_t DeltaClassicJsonValue::GetInteger(const string &key, int64_t default_value) const {
+	auto value = Get(key);
+	if (!value || value->type != DeltaClassicJsonType::NUMBER) {
+		return default_value;
+	}
+	return std::stoll(value->str);
+}
+
+} // namespace duckdb
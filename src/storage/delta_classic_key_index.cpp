@@ -0,0 +1,266 @@
+#include "storage/delta_classic_key_index.hpp"
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_parallel.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/blob.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+
+namespace duckdb {
+
+// Tab-separated text, one record per line:
+//   delta_classic_key_index <format version> <bloom hash> <column> <type>
+//   version <table version>
+//   file <path> <size> <min> <max> <bloom filter, base64>      (min/max empty for files holding only NULLs)
+// Paths and values are escaped, so they never contain tabs or newlines.
+static constexpr const char *INDEX_MAGIC = "delta_classic_key_index";
+static constexpr const char *INDEX_VERSION = "2";
+//! The hash the bloom filters are built with (KeyHash); an index built with another one is built again
+static constexpr const char *INDEX_HASH = "fnv1a64";
+static constexpr const char *INDEX_DIRECTORY_NAME = "_delta_classic_index";
+
+static string Escape(const string &str) {
+	string result;
+	for (auto c : str) {
+		if (c == '\\') {
+			result += "\\\\";
+		} else if (c == '\t') {
+			result += "\\t";
+		} else if (c == '\n') {
+			result += "\\n";
+		} else {
+			result += c;
+		}
+	}
+	return result;
+}
+
+static string Unescape(const string &str) {
+	string result;
+	for (idx_t i = 0; i < str.size(); i++) {
+		if (str[i] != '\\' || i + 1 == str.size()) {
+			result += str[i];
+			continue;
+		}
+		auto next = str[++i];
+		result += next == 't' ? '\t' : next == 'n' ? '\n' : next;
+	}
+	return result;
+}
+
+static string QuoteLiteral(const string &str) {
+	return "'" + StringUtil::Replace(str, "'", "''") + "'";
+}
+
+//! Hash of a value for the bloom filters, over a fixed encoding: the bytes of strings and blobs, the text of any
+//! other value in the column's type. Unlike Value::Hash, which may change between DuckDB releases, it stays the same
+//! for as long as the index files written with it.
+static hash_t KeyHash(const Value &value) {
+	auto type = value.type().InternalType();
+	auto key = type == PhysicalType::VARCHAR ? StringValue::Get(value) : value.ToString();
+	// 64-bit FNV-1a, followed by a finalizer that spreads the bits the double hashing takes its step from
+	uint64_t hash = 14695981039346656037ULL;
+	for (auto c : key) {
+		hash = (hash ^ uint8_t(c)) * 1099511628211ULL;
+	}
+	hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+	return hash ^ (hash >> 31);
+}
+
+//! Bit positions of a value by double hashing
+template <class CALLBACK>
+static void ForEachBit(hash_t hash, idx_t bit_count, CALLBACK &&callback) {
+	auto step = (hash >> 32) | 1;
+	for (idx_t i = 0; i < DeltaClassicKeyIndex::HASH_COUNT; i++) {
+		callback((hash + i * step) % bit_count);
+	}
+}
+
+DeltaClassicKeyIndex::DeltaClassicKeyIndex(string column, LogicalType type)
+    : column(std::move(column)), type(std::move(type)) {
+}
+
+string DeltaClassicKeyIndex::GetPath(FileSystem &fs, const string &index_directory, const string &table_path,
+                                     const string &column) {
+	auto column_key = std::to_string(Hash(column.c_str(), column.size()));
+	if (index_directory.empty()) {
+		return fs.JoinPath(fs.JoinPath(table_path, INDEX_DIRECTORY_NAME), "key_" + column_key + ".index");
+	}
+	auto table_key = std::to_string(Hash(table_path.c_str(), table_path.size()));
+	return fs.JoinPath(index_directory, "key_" + table_key + "_" + column_key + ".index");
+}
+
+unique_ptr<DeltaClassicKeyIndex> DeltaClassicKeyIndex::Read(FileSystem &fs, const string &path, const string &column,
+                                                            const LogicalType &type) {
+	if (!fs.FileExists(path)) {
+		return nullptr;
+	}
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	auto file_size = handle->GetFileSize();
+	string contents(file_size, '\0');
+	handle->Read((void *)contents.data(), file_size);
+
+	auto lines = StringUtil::Split(contents, '\n');
+	if (lines.empty()) {
+		return nullptr;
+	}
+	auto header = StringUtil::Split(lines[0], '\t');
+	if (header.size() != 5 || header[0] != INDEX_MAGIC || header[1] != INDEX_VERSION || header[2] != INDEX_HASH ||
+	    Unescape(header[3]) != column || header[4] != type.ToString()) {
+		return nullptr;
+	}
+
+	auto result = make_uniq<DeltaClassicKeyIndex>(column, type);
+	for (idx_t i = 1; i < lines.size(); i++) {
+		// Split drops empty fields, so split by hand: min and max are empty for files holding only NULLs
+		vector<string> fields;
+		idx_t start = 0;
+		for (idx_t end; (end = lines[i].find('\t', start)) != string::npos; start = end + 1) {
+			fields.push_back(lines[i].substr(start, end - start));
+		}
+		fields.push_back(lines[i].substr(start));
+		if (fields.size() == 2 && fields[0] == "version") {
+			result->version = std::stoll(fields[1]);
+		} else if (fields.size() == 6 && fields[0] == "file") {
+			FileEntry entry;
+			entry.size = std::stoull(fields[2]);
+			if (!fields[3].empty()) {
+				entry.min = Value(Unescape(fields[3])).DefaultCastAs(type);
+				entry.max = Value(Unescape(fields[4])).DefaultCastAs(type);
+			}
+			auto bloom_size = Blob::FromBase64Size(fields[5]);
+			entry.bloom.resize(bloom_size);
+			Blob::FromBase64(fields[5], data_ptr_cast(&entry.bloom[0]), bloom_size);
+			result->files[Unescape(fields[1])] = std::move(entry);
+		} else {
+			// Truncated or foreign file: the index is built again
+			return nullptr;
+		}
+	}
+	return result;
+}
+
+void DeltaClassicKeyIndex::Write(FileSystem &fs, const string &path) const {
+	string contents;
+	contents += string(INDEX_MAGIC) + "\t" + INDEX_VERSION + "\t" + INDEX_HASH + "\t" + Escape(column) + "\t" +
+	            type.ToString() + "\n";
+	contents += "version\t" + std::to_string(version) + "\n";
+	for (auto &file : files) {
+		auto &entry = file.second;
+		contents += "file\t" + Escape(file.first) + "\t" + std::to_string(entry.size) + "\t";
+		if (!entry.min.IsNull()) {
+			contents += Escape(entry.min.ToString()) + "\t" + Escape(entry.max.ToString());
+		} else {
+			contents += "\t";
+		}
+		contents += "\t" + Blob::ToBase64(string_t(entry.bloom)) + "\n";
+	}
+
+	auto directory = path.substr(0, path.find_last_of("/\\"));
+	if (!fs.DirectoryExists(directory)) {
+		fs.CreateDirectory(directory);
+	}
+	// Write to a unique temporary file and rename, so concurrent readers never see a partial index
+	auto temp_path = path + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp";
+	{
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write((void *)contents.data(), contents.size());
+		handle->Sync();
+	}
+	fs.MoveFile(temp_path, path);
+}
+
+DeltaClassicKeyIndex::FileEntry DeltaClassicKeyIndex::BuildEntry(DatabaseInstance &db, const string &file_path,
+                                                                 idx_t size) const {
+	// Values are cast to the column's type in the table, so they hash like the constants of a lookup
+	auto sql = "SELECT DISTINCT CAST(" + KeywordHelper::WriteOptionallyQuoted(column) + " AS " + type.ToString() +
+	           ") FROM read_parquet(" + QuoteLiteral(file_path) + ")";
+	Connection con(db);
+	auto result = con.Query(sql);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+
+	FileEntry entry;
+	entry.size = size;
+	vector<hash_t> hashes;
+	for (auto &chunk : result->Collection().Chunks()) {
+		for (idx_t row = 0; row < chunk.size(); row++) {
+			auto value = chunk.GetValue(0, row);
+			if (value.IsNull()) {
+				continue;
+			}
+			if (entry.min.IsNull() || value < entry.min) {
+				entry.min = value;
+			}
+			if (entry.max.IsNull() || value > entry.max) {
+				entry.max = value;
+			}
+			hashes.push_back(KeyHash(value));
+		}
+	}
+	auto bit_count = MaxValue<idx_t>(hashes.size() * BITS_PER_VALUE, 64);
+	entry.bloom.assign((bit_count + 7) / 8, '\0');
+	bit_count = entry.bloom.size() * 8;
+	for (auto hash : hashes) {
+		ForEachBit(hash, bit_count, [&](idx_t bit) { entry.bloom[bit / 8] |= char(1 << (bit % 8)); });
+	}
+	return entry;
+}
+
+idx_t DeltaClassicKeyIndex::Update(DatabaseInstance &db, const string &table_path,
+                                   const DeltaClassicSnapshot &snapshot, idx_t max_threads) {
+	unordered_map<string, FileEntry> current;
+	vector<reference<const DeltaClassicDataFile>> new_files;
+	for (auto &file : snapshot.files) {
+		auto entry = files.find(file.path);
+		if (entry != files.end() && entry->second.size == file.size) {
+			current[file.path] = std::move(entry->second);
+		} else {
+			new_files.push_back(file);
+		}
+	}
+
+	vector<FileEntry> new_entries(new_files.size());
+	DeltaClassicParallel::ForEach(new_files.size(), max_threads, [&](idx_t i) {
+		auto &file = new_files[i].get();
+		new_entries[i] = BuildEntry(db, DeltaClassicSnapshot::GetAbsolutePath(table_path, file.path), file.size);
+	});
+	for (idx_t i = 0; i < new_files.size(); i++) {
+		current[new_files[i].get().path] = std::move(new_entries[i]);
+	}
+	files = std::move(current);
+	version = snapshot.version;
+	return new_files.size();
+}
+
+bool DeltaClassicKeyIndex::MayContain(const string &path, idx_t size, const Value &value) const {
+	auto entry = files.find(path);
+	if (entry == files.end() || entry->second.size != size) {
+		return true;
+	}
+	auto &file = entry->second;
+	if (value.IsNull() || file.min.IsNull()) {
+		// Equality never matches NULL; a file without values holds no match either
+		return false;
+	}
+	if (value < file.min || value > file.max) {
+		return false;
+	}
+	auto bit_count = file.bloom.size() * 8;
+	bool may_contain = true;
+	ForEachBit(KeyHash(value), bit_count, [&](idx_t bit) {
+		may_contain = may_contain && (file.bloom[bit / 8] & char(1 << (bit % 8)));
+	});
+	return may_contain;
+}
+
+} // namespace duckdb
@@ -0,0 +1,978 @@
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_parallel.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+//! Paths in the Delta log are URIs, so e.g. spaces in partition values appear as %20
+static string DecodePath(const string &path) {
+	string result;
+	for (idx_t i = 0; i < path.size(); i++) {
+		if (path[i] == '%' && i + 2 < path.size() && isxdigit(path[i + 1]) && isxdigit(path[i + 2])) {
+			result += char(std::stoi(path.substr(i + 1, 2), nullptr, 16));
+			i += 2;
+		} else {
+			result += path[i];
+		}
+	}
+	return result;
+}
+
+static Value GetStructField(const Value &value, const string &name) {
+	if (value.IsNull() || value.type().id() != LogicalTypeId::STRUCT) {
+		return Value();
+	}
+	auto &child_types = StructType::GetChildTypes(value.type());
+	auto &children = StructValue::GetChildren(value);
+	for (idx_t i = 0; i < child_types.size(); i++) {
+		if (child_types[i].first == name) {
+			return children[i];
+		}
+	}
+	return Value();
+}
+
+static void SetRecordCount(DeltaClassicDataFile &file, int64_t num_records, int64_t deleted_records) {
+	if (num_records < 0 || (file.has_deletion_vector && deleted_records < 0)) {
+		return;
+	}
+	file.num_records = idx_t(num_records - (file.has_deletion_vector ? deleted_records : 0));
+}
+
+static void ParseStats(DeltaClassicDataFile &file, const string &stats) {
+	if (stats.empty()) {
+		return;
+	}
+	try {
+		file.stats = DeltaClassicJsonValue::Parse(stats);
+	} catch (std::exception &) {
+		// Unparseable statistics are treated like missing ones
+	}
+}
+
+static bool IsDigits(const string &str) {
+	if (str.empty()) {
+		return false;
+	}
+	for (auto c : str) {
+		if (!isdigit(c)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static string QuoteLiteral(const string &str) {
+	return "'" + StringUtil::Replace(str, "'", "''") + "'";
+}
+
+static void ApplyMetadata(const DeltaClassicJsonValue &metadata, DeltaClassicSnapshot &snapshot) {
+	snapshot.schema_string = metadata.GetString("schemaString");
+	snapshot.partition_columns.clear();
+	auto partition_columns = metadata.Get("partitionColumns");
+	if (partition_columns) {
+		for (auto &column : partition_columns->children) {
+			snapshot.partition_columns.push_back(column->str);
+		}
+	}
+	snapshot.configuration.clear();
+	auto configuration = metadata.Get("configuration");
+	if (configuration) {
+		for (idx_t i = 0; i < configuration->keys.size(); i++) {
+			snapshot.configuration[configuration->keys[i]] = configuration->children[i]->str;
+		}
+	}
+}
+
+static DeltaClassicDataFile ParseAddAction(const DeltaClassicJsonValue &add) {
+	DeltaClassicDataFile file;
+	file.path = DecodePath(add.GetString("path"));
+	file.size = idx_t(MaxValue<int64_t>(add.GetInteger("size", 0), 0));
+	auto partition_values = add.Get("partitionValues");
+	if (partition_values) {
+		for (idx_t i = 0; i < partition_values->keys.size(); i++) {
+			auto &value = *partition_values->children[i];
+			file.partition_values[partition_values->keys[i]] = value.IsNull() ? Value() : Value(value.str);
+		}
+	}
+	ParseStats(file, add.GetString("stats"));
+	auto deletion_vector = add.Get("deletionVector");
+	file.has_deletion_vector = deletion_vector && !deletion_vector->IsNull();
+	SetRecordCount(file, file.stats ? file.stats->GetInteger("numRecords", -1) : -1,
+	               file.has_deletion_vector ? deletion_vector->GetInteger("cardinality", -1) : 0);
+	return file;
+}
+
+//! Whether an add or remove action changes the table's rows; compaction rewrites files with dataChange false
+static bool IsDataChange(const DeltaClassicJsonValue &action) {
+	auto data_change = action.Get("dataChange");
+	return !data_change || data_change->str != "false";
+}
+
+//! Maps a Delta schema type (a primitive type name, or a struct/array/map object) to the DuckDB type
+static bool TryConvertDeltaType(const DeltaClassicJsonValue &type, LogicalType &result) {
+	if (type.type == DeltaClassicJsonType::STRING) {
+		auto &name = type.str;
+		if (name == "string") {
+			result = LogicalType::VARCHAR;
+		} else if (name == "long") {
+			result = LogicalType::BIGINT;
+		} else if (name == "integer") {
+			result = LogicalType::INTEGER;
+		} else if (name == "short") {
+			result = LogicalType::SMALLINT;
+		} else if (name == "byte") {
+			result = LogicalType::TINYINT;
+		} else if (name == "float") {
+			result = LogicalType::FLOAT;
+		} else if (name == "double") {
+			result = LogicalType::DOUBLE;
+		} else if (name == "boolean") {
+			result = LogicalType::BOOLEAN;
+		} else if (name == "binary") {
+			result = LogicalType::BLOB;
+		} else if (name == "date") {
+			result = LogicalType::DATE;
+		} else if (name == "timestamp") {
+			result = LogicalType::TIMESTAMP_TZ;
+		} else if (name == "timestamp_ntz") {
+			result = LogicalType::TIMESTAMP;
+		} else if (StringUtil::StartsWith(name, "decimal(") && StringUtil::EndsWith(name, ")")) {
+			auto parameters = StringUtil::Split(name.substr(8, name.size() - 9), ',');
+			if (parameters.size() != 2) {
+				return false;
+			}
+			StringUtil::Trim(parameters[0]);
+			StringUtil::Trim(parameters[1]);
+			if (!IsDigits(parameters[0]) || !IsDigits(parameters[1])) {
+				return false;
+			}
+			auto width = std::stoi(parameters[0]);
+			auto scale = std::stoi(parameters[1]);
+			if (width < 1 || width > Decimal::MAX_WIDTH_DECIMAL || scale > width) {
+				return false;
+			}
+			result = LogicalType::DECIMAL(uint8_t(width), uint8_t(scale));
+		} else {
+			return false;
+		}
+		return true;
+	}
+	if (type.type != DeltaClassicJsonType::OBJECT) {
+		return false;
+	}
+	auto kind = type.GetString("type");
+	if (kind == "struct") {
+		auto fields = type.Get("fields");
+		if (!fields || fields->children.empty()) {
+			return false;
+		}
+		child_list_t<LogicalType> children;
+		for (auto &field : fields->children) {
+			auto field_type = field->Get("type");
+			LogicalType child_type;
+			if (!field_type || !TryConvertDeltaType(*field_type, child_type)) {
+				return false;
+			}
+			children.emplace_back(field->GetString("name"), std::move(child_type));
+		}
+		result = LogicalType::STRUCT(std::move(children));
+		return true;
+	}
+	if (kind == "array") {
+		auto element_type = type.Get("elementType");
+		LogicalType child_type;
+		if (!element_type || !TryConvertDeltaType(*element_type, child_type)) {
+			return false;
+		}
+		result = LogicalType::LIST(std::move(child_type));
+		return true;
+	}
+	if (kind == "map") {
+		auto key_type = type.Get("keyType");
+		auto value_type = type.Get("valueType");
+		LogicalType key;
+		LogicalType value;
+		if (!key_type || !value_type || !TryConvertDeltaType(*key_type, key) ||
+		    !TryConvertDeltaType(*value_type, value)) {
+			return false;
+		}
+		result = LogicalType::MAP(std::move(key), std::move(value));
+		return true;
+	}
+	return false;
+}
+
+//===--------------------------------------------------------------------===//
+// DeltaClassicSnapshot
+//===--------------------------------------------------------------------===//
+bool DeltaClassicSnapshot::TryGetColumns(ColumnList &result) const {
+	unique_ptr<DeltaClassicJsonValue> schema;
+	try {
+		schema = DeltaClassicJsonValue::Parse(schema_string);
+	} catch (std::exception &) {
+		return false;
+	}
+	auto fields = schema->Get("fields");
+	if (!fields || fields->children.empty()) {
+		return false;
+	}
+	ColumnList columns;
+	case_insensitive_set_t names;
+	for (auto &field : fields->children) {
+		auto name = field->GetString("name");
+		auto field_type = field->Get("type");
+		LogicalType type;
+		if (name.empty() || !names.insert(name).second || !field_type || !TryConvertDeltaType(*field_type, type)) {
+			return false;
+		}
+		columns.AddColumn(ColumnDefinition(name, std::move(type)));
+	}
+	result = std::move(columns);
+	return true;
+}
+
+optional_idx DeltaClassicSnapshot::GetRowCount() const {
+	idx_t result = 0;
+	for (auto &file : files) {
+		if (!file.num_records.IsValid()) {
+			return optional_idx();
+		}
+		result += file.num_records.GetIndex();
+	}
+	return result;
+}
+
+idx_t DeltaClassicSnapshot::GetTotalSize() const {
+	idx_t result = 0;
+	for (auto &file : files) {
+		result += file.size;
+	}
+	return result;
+}
+
+static bool SupportsMinMax(const LogicalType &type) {
+	// Floating point stats are ambiguous around NaN, and string stats are truncated by writers
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::DECIMAL:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool TryCastStat(const string &str, const LogicalType &type, Value &result) {
+	return Value(str).DefaultTryCastAs(type, result, nullptr);
+}
+
+//! Timestamp statistics are written with millisecond precision, so the real maximum can be up to 999us later
+static Value WidenTimestampMax(const Value &max) {
+	auto micros = max.GetValueUnsafe<int64_t>();
+	if (max.type().id() == LogicalTypeId::TIMESTAMP_TZ) {
+		return Value::TIMESTAMPTZ(timestamp_tz_t(micros + 999));
+	}
+	return Value::TIMESTAMP(timestamp_t(micros + 999));
+}
+
+unique_ptr<BaseStatistics> DeltaClassicSnapshot::GetColumnStatistics(const string &column_name,
+                                                                     const LogicalType &type) const {
+	if (HasColumnMapping()) {
+		// Statistics are keyed by physical column names, which differ from the logical ones
+		return nullptr;
+	}
+	bool is_partition_column = IsPartitionColumn(column_name);
+
+	bool has_min_max = SupportsMinMax(type);
+	bool null_info_known = true;
+	bool has_null = false;
+	bool has_valid = false;
+	Value min;
+	Value max;
+	auto update_min_max = [&](const Value &file_min, const Value &file_max) {
+		if (min.IsNull() || file_min < min) {
+			min = file_min;
+		}
+		if (max.IsNull() || file_max > max) {
+			max = file_max;
+		}
+	};
+
+	for (auto &file : files) {
+		if (is_partition_column) {
+			// Partition values are exact
+			auto entry = file.partition_values.find(column_name);
+			if (entry == file.partition_values.end() || entry->second.IsNull()) {
+				has_null = true;
+				continue;
+			}
+			has_valid = true;
+			Value value;
+			if (has_min_max && TryCastStat(entry->second.ToString(), type, value)) {
+				update_min_max(value, value);
+			} else {
+				has_min_max = false;
+			}
+			continue;
+		}
+
+		int64_t null_count = -1;
+		int64_t row_count = -1;
+		if (file.stats) {
+			auto null_counts = file.stats->Get("nullCount");
+			null_count = null_counts ? null_counts->GetInteger(column_name, -1) : -1;
+			row_count = file.stats->GetInteger("numRecords", -1);
+		}
+		if (null_count < 0 || row_count < 0) {
+			null_info_known = false;
+			has_min_max = false;
+			continue;
+		}
+		has_null = has_null || null_count > 0;
+		if (null_count == row_count) {
+			// All values in this file are NULL, so it has no min/max to contribute
+			continue;
+		}
+		has_valid = true;
+		if (!has_min_max) {
+			continue;
+		}
+		optional_ptr<const DeltaClassicJsonValue> file_min;
+		optional_ptr<const DeltaClassicJsonValue> file_max;
+		auto min_values = file.stats->Get("minValues");
+		auto max_values = file.stats->Get("maxValues");
+		if (min_values && max_values) {
+			file_min = min_values->Get(column_name);
+			file_max = max_values->Get(column_name);
+		}
+		Value min_value;
+		Value max_value;
+		if (!file_min || !file_max || file_min->IsNull() || file_max->IsNull() ||
+		    !TryCastStat(file_min->str, type, min_value) || !TryCastStat(file_max->str, type, max_value)) {
+			has_min_max = false;
+			continue;
+		}
+		if (type.id() == LogicalTypeId::TIMESTAMP || type.id() == LogicalTypeId::TIMESTAMP_TZ) {
+			max_value = WidenTimestampMax(max_value);
+		}
+		update_min_max(min_value, max_value);
+	}
+
+	if (!null_info_known) {
+		has_null = true;
+		has_valid = true;
+	}
+	unique_ptr<BaseStatistics> result;
+	if (has_min_max && has_valid && !min.IsNull()) {
+		result = NumericStats::CreateEmpty(type).ToUnique();
+		NumericStats::SetMin(*result, min);
+		NumericStats::SetMax(*result, max);
+	} else {
+		result = BaseStatistics::CreateUnknown(type).ToUnique();
+		if (!has_null && !has_valid) {
+			// No files: the table is empty
+			return result;
+		}
+		result->Set(has_null ? (has_valid ? StatsInfo::CAN_HAVE_NULL_AND_VALID_VALUES
+		                                  : StatsInfo::CANNOT_HAVE_VALID_VALUES)
+		                     : StatsInfo::CANNOT_HAVE_NULL_VALUES);
+		return result;
+	}
+	if (has_null) {
+		result->SetHasNull();
+	}
+	result->SetHasNoNull();
+	return result;
+}
+
+bool DeltaClassicSnapshot::HasColumnMapping() const {
+	auto mapping_mode = configuration.find("delta.columnMapping.mode");
+	return mapping_mode != configuration.end() && mapping_mode->second != "none";
+}
+
+bool DeltaClassicSnapshot::IsPartitionColumn(const string &column_name) const {
+	return std::find(partition_columns.begin(), partition_columns.end(), column_name) != partition_columns.end();
+}
+
+bool DeltaClassicSnapshot::TryGetPartitionValue(const DeltaClassicDataFile &file, const string &column_name,
+                                                const LogicalType &type, Value &result) const {
+	auto entry = file.partition_values.find(column_name);
+	if (entry == file.partition_values.end() || entry->second.IsNull()) {
+		result = Value(type);
+		return true;
+	}
+	return TryCastStat(entry->second.ToString(), type, result);
+}
+
+bool DeltaClassicSnapshot::TryGetExactCount(const vector<idx_t> &file_ids, const string &column_name,
+                                            idx_t &result) const {
+	bool is_partition_column = !column_name.empty() && IsPartitionColumn(column_name);
+	result = 0;
+	for (auto file_id : file_ids) {
+		auto &file = files[file_id];
+		if (!file.num_records.IsValid()) {
+			return false;
+		}
+		auto row_count = file.num_records.GetIndex();
+		if (column_name.empty()) {
+			result += row_count;
+			continue;
+		}
+		if (is_partition_column) {
+			auto entry = file.partition_values.find(column_name);
+			if (entry != file.partition_values.end() && !entry->second.IsNull()) {
+				result += row_count;
+			}
+			continue;
+		}
+		// Null counts also cover rows removed by a deletion vector
+		if (file.has_deletion_vector || !file.stats) {
+			return false;
+		}
+		auto null_counts = file.stats->Get("nullCount");
+		auto null_count = null_counts ? null_counts->GetInteger(column_name, -1) : -1;
+		if (null_count < 0 || idx_t(null_count) > row_count) {
+			return false;
+		}
+		result += row_count - idx_t(null_count);
+	}
+	return true;
+}
+
+//! Types whose min/max statistics are written without loss, so they are the actual extremes of the file
+static bool HasExactMinMax(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::DECIMAL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool DeltaClassicSnapshot::TryGetExactMinMax(const vector<idx_t> &file_ids, const string &column_name,
+                                             const LogicalType &type, Value &min, Value &max) const {
+	bool is_partition_column = IsPartitionColumn(column_name);
+	if (type.IsNested() || (!is_partition_column && !HasExactMinMax(type))) {
+		return false;
+	}
+	min = Value(type);
+	max = Value(type);
+	for (auto file_id : file_ids) {
+		auto &file = files[file_id];
+		Value file_min;
+		Value file_max;
+		if (is_partition_column) {
+			if (!TryGetPartitionValue(file, column_name, type, file_min)) {
+				return false;
+			}
+			file_max = file_min;
+		} else {
+			// Rows removed by a deletion vector may hold the extremes
+			if (file.has_deletion_vector || !file.stats) {
+				return false;
+			}
+			auto row_count = file.stats->GetInteger("numRecords", -1);
+			auto null_counts = file.stats->Get("nullCount");
+			auto null_count = null_counts ? null_counts->GetInteger(column_name, -1) : -1;
+			if (row_count < 0 || null_count < 0) {
+				return false;
+			}
+			if (null_count == row_count) {
+				continue;
+			}
+			auto min_values = file.stats->Get("minValues");
+			auto max_values = file.stats->Get("maxValues");
+			if (!min_values || !max_values) {
+				return false;
+			}
+			auto min_stat = min_values->Get(column_name);
+			auto max_stat = max_values->Get(column_name);
+			if (!min_stat || !max_stat || min_stat->IsNull() || max_stat->IsNull() ||
+			    !TryCastStat(min_stat->str, type, file_min) || !TryCastStat(max_stat->str, type, file_max)) {
+				return false;
+			}
+		}
+		if (file_min.IsNull()) {
+			continue;
+		}
+		if (min.IsNull() || file_min < min) {
+			min = file_min;
+		}
+		if (max.IsNull() || file_max > max) {
+			max = file_max;
+		}
+	}
+	return true;
+}
+
+string DeltaClassicSnapshot::GetAbsolutePath(const string &table_path, const string &file_path) {
+	if (file_path.find("://") != string::npos || StringUtil::StartsWith(file_path, "/")) {
+		return file_path;
+	}
+	return table_path + "/" + file_path;
+}
+
+string DeltaClassicSnapshot::GetFilesQuery(const string &table_path, const ColumnList &columns,
+                                           const vector<DeltaClassicFileChange> &files) const {
+	// files(path, version, <partition columns>) lists the data files
+	vector<string> paths;
+	vector<string> file_rows;
+	for (auto &change : files) {
+		paths.push_back(QuoteLiteral(GetAbsolutePath(table_path, change.file.path)));
+		vector<string> row {paths.back(), std::to_string(change.version)};
+		for (auto &partition_column : partition_columns) {
+			auto value = change.file.partition_values.find(partition_column);
+			row.push_back(value == change.file.partition_values.end() || value->second.IsNull()
+			                  ? "NULL"
+			                  : QuoteLiteral(value->second.ToString()));
+		}
+		file_rows.push_back("(" + StringUtil::Join(row, ", ") + ")");
+	}
+
+	vector<string> file_columns {"path", "version"};
+	for (idx_t i = 0; i < partition_columns.size(); i++) {
+		file_columns.push_back("partition_" + std::to_string(i));
+	}
+	vector<string> select_list;
+	// An empty row of every data column, which the files are unioned with by name
+	vector<string> empty_row;
+	for (auto &column : columns.Logical()) {
+		auto name = KeywordHelper::WriteOptionallyQuoted(column.Name());
+		auto type = column.Type().ToString();
+		string source = "data." + name;
+		auto partition = std::find(partition_columns.begin(), partition_columns.end(), column.Name());
+		if (file_rows.empty()) {
+			source = "NULL";
+		} else if (partition != partition_columns.end()) {
+			// Partition values are stored in the log only
+			source = "files." + file_columns[2 + idx_t(partition - partition_columns.begin())];
+		} else {
+			empty_row.push_back("CAST(NULL AS " + type + ") AS " + name);
+		}
+		select_list.push_back("CAST(" + source + " AS " + type + ") AS " + name);
+	}
+	select_list.push_back(string("CAST(") + (file_rows.empty() ? "NULL" : "files.version") +
+	                      " AS BIGINT) AS _commit_version");
+
+	string query = "SELECT " + StringUtil::Join(select_list, ", ");
+	if (file_rows.empty()) {
+		return query + " WHERE false";
+	}
+	// read_parquet only has the columns some file holds: columns added by a schema change after the files were
+	// written come from the empty row, so they read as NULL
+	empty_row.push_back("CAST(NULL AS VARCHAR) AS filename");
+	auto data = "SELECT " + StringUtil::Join(empty_row, ", ") + " WHERE false UNION ALL BY NAME SELECT * FROM " +
+	            "read_parquet([" + StringUtil::Join(paths, ", ") + "], filename = true, union_by_name = true)";
+	return query + " FROM (" + data + ") AS data JOIN (VALUES " + StringUtil::Join(file_rows, ", ") + ") AS files(" +
+	       StringUtil::Join(file_columns, ", ") + ") ON data.filename = files.path";
+}
+
+//===--------------------------------------------------------------------===//
+// DeltaClassicLogReader
+//===--------------------------------------------------------------------===//
+DeltaClassicLogReader::DeltaClassicLogReader(DatabaseInstance &db, FileSystem &fs, const string &table_path,
+                                             idx_t max_threads)
+    : db(db), fs(fs), table_path(table_path), log_path(table_path + "/_delta_log"), max_threads(max_threads) {
+}
+
+string DeltaClassicLogReader::CommitFileName(int64_t version) {
+	auto digits = std::to_string(version);
+	return string(20 - MinValue<idx_t>(digits.size(), 20), '0') + digits + ".json";
+}
+
+DeltaClassicLogReader::LogListing DeltaClassicLogReader::ListLog() {
+	LogListing result;
+	// version -> (number of parts, part number -> file)
+	map<int64_t, pair<idx_t, map<idx_t, string>>> checkpoint_parts;
+
+	fs.ListFiles(log_path, [&](const string &path, bool is_directory) {
+		if (is_directory) {
+			return;
+		}
+		auto filename = path.substr(path.find_last_of('/') + 1);
+		if (filename.size() < 22 || filename[20] != '.' || !IsDigits(filename.substr(0, 20))) {
+			return;
+		}
+		auto version = std::stoll(filename.substr(0, 20));
+		auto suffix = filename.substr(21);
+		if (suffix == "json") {
+			result.commits.push_back(version);
+			return;
+		}
+		auto full_path = log_path + "/" + filename;
+		if (suffix == "checkpoint.parquet") {
+			checkpoint_parts[version] = make_pair(idx_t(1), map<idx_t, string> {{1, full_path}});
+			return;
+		}
+		// Multi-part checkpoint: <version>.checkpoint.<part>.<parts>.parquet
+		// V2 checkpoints (<version>.checkpoint.<uuid>.parquet) reference sidecars and are not supported here
+		auto components = StringUtil::Split(suffix, '.');
+		if (components.size() == 4 && components[0] == "checkpoint" && components[3] == "parquet" &&
+		    IsDigits(components[1]) && IsDigits(components[2])) {
+			auto &parts = checkpoint_parts[version];
+			parts.first = std::stoull(components[2]);
+			parts.second[std::stoull(components[1])] = full_path;
+		}
+	});
+
+	std::sort(result.commits.begin(), result.commits.end());
+	for (auto &entry : checkpoint_parts) {
+		if (entry.second.second.size() != entry.second.first) {
+			// Incomplete (e.g. still being written)
+			continue;
+		}
+		auto &files = result.checkpoints[entry.first];
+		for (auto &part : entry.second.second) {
+			files.push_back(part.second);
+		}
+	}
+	return result;
+}
+
+int64_t DeltaClassicLogReader::GetLatestVersion() {
+	auto listing = ListLog();
+	int64_t result = -1;
+	if (!listing.commits.empty()) {
+		result = listing.commits.back();
+	}
+	if (!listing.checkpoints.empty()) {
+		result = MaxValue<int64_t>(result, listing.checkpoints.rbegin()->first);
+	}
+	return result;
+}
+
+int64_t DeltaClassicLogReader::ReadCommitTimestamp(int64_t version) {
+	auto contents = ReadFile(log_path + "/" + CommitFileName(version));
+	for (auto &line : StringUtil::Split(contents, '\n')) {
+		StringUtil::Trim(line);
+		if (line.empty()) {
+			continue;
+		}
+		auto action = DeltaClassicJsonValue::Parse(line);
+		if (auto commit_info = action->Get("commitInfo")) {
+			return commit_info->GetInteger("inCommitTimestamp", commit_info->GetInteger("timestamp", -1));
+		}
+	}
+	return -1;
+}
+
+int64_t DeltaClassicLogReader::GetVersionAtTimestamp(int64_t timestamp_ms) {
+	auto listing = ListLog();
+	auto &commits = listing.commits;
+	// Writers' clocks may be skewed, so commit timestamps need not increase with the version. As in Delta time
+	// travel, a commit counts as made no earlier than the commits before it: the result is the version before the
+	// first commit newer than the timestamp. Commits are read oldest first, in parallel batches.
+	auto batch_size = MaxValue<idx_t>(max_threads, 1);
+	for (idx_t batch_start = 0; batch_start < commits.size(); batch_start += batch_size) {
+		auto batch_end = MinValue<idx_t>(batch_start + batch_size, commits.size());
+		vector<int64_t> timestamps(batch_end - batch_start);
+		DeltaClassicParallel::ForEach(timestamps.size(), max_threads, [&](idx_t i) {
+			timestamps[i] = ReadCommitTimestamp(commits[batch_start + i]);
+		});
+		for (idx_t i = 0; i < timestamps.size(); i++) {
+			auto index = batch_start + i;
+			if (timestamps[i] < 0) {
+				throw IOException("Commit %lld of Delta table \"%s\" has no timestamp", commits[index], table_path);
+			}
+			if (timestamps[i] <= timestamp_ms) {
+				continue;
+			}
+			if (index == 0) {
+				throw IOException(
+				    "Delta table \"%s\" has no version committed at or before the requested timestamp", table_path);
+			}
+			return commits[index - 1];
+		}
+	}
+	if (commits.empty()) {
+		throw IOException("Delta table \"%s\" has no version committed at or before the requested timestamp",
+		                  table_path);
+	}
+	return commits.back();
+}
+
+string DeltaClassicLogReader::ReadFile(const string &path) {
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	auto file_size = handle->GetFileSize();
+	string contents(file_size, '\0');
+	handle->Read((void *)contents.data(), file_size);
+	return contents;
+}
+
+void DeltaClassicLogReader::ReadCheckpoint(const vector<string> &part_files, DeltaClassicSnapshot &snapshot,
+                                           optional_ptr<unordered_map<string, DeltaClassicDataFile>> active_files) {
+	// Checkpoints are parquet files; read them through a separate connection, which is safe while the
+	// calling client is in the middle of binding a query
+	vector<string> quoted_files;
+	for (auto &file : part_files) {
+		quoted_files.push_back(QuoteLiteral(file));
+	}
+	string columns = active_files ? "add, metaData" : "NULL AS add, metaData";
+	string filter = active_files ? "add IS NOT NULL OR metaData IS NOT NULL" : "metaData IS NOT NULL";
+	Connection con(db);
+	auto result = con.Query("SELECT " + columns + " FROM read_parquet([" + StringUtil::Join(quoted_files, ", ") +
+	                        "]) WHERE " + filter);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+
+	for (idx_t row = 0; row < result->RowCount(); row++) {
+		auto add = result->GetValue(0, row);
+		if (active_files && !add.IsNull()) {
+			DeltaClassicDataFile file;
+			file.path = DecodePath(GetStructField(add, "path").ToString());
+			auto size = GetStructField(add, "size");
+			file.size = size.IsNull() ? 0 : size.GetValue<idx_t>();
+			auto partition_values = GetStructField(add, "partitionValues");
+			if (!partition_values.IsNull()) {
+				for (auto &entry : MapValue::GetChildren(partition_values)) {
+					auto &key_value = StructValue::GetChildren(entry);
+					file.partition_values[key_value[0].ToString()] =
+					    key_value[1].IsNull() ? Value() : Value(key_value[1].ToString());
+				}
+			}
+			auto stats = GetStructField(add, "stats");
+			ParseStats(file, stats.IsNull() ? string() : stats.ToString());
+			auto deletion_vector = GetStructField(add, "deletionVector");
+			file.has_deletion_vector = !deletion_vector.IsNull();
+			auto cardinality = GetStructField(deletion_vector, "cardinality");
+			SetRecordCount(file, file.stats ? file.stats->GetInteger("numRecords", -1) : -1,
+			               cardinality.IsNull() ? -1 : cardinality.GetValue<int64_t>());
+			(*active_files)[file.path] = std::move(file);
+		}
+
+		auto metadata = result->GetValue(1, row);
+		if (!metadata.IsNull()) {
+			snapshot.schema_string = GetStructField(metadata, "schemaString").ToString();
+			snapshot.partition_columns.clear();
+			auto partition_columns = GetStructField(metadata, "partitionColumns");
+			if (!partition_columns.IsNull()) {
+				for (auto &column : ListValue::GetChildren(partition_columns)) {
+					snapshot.partition_columns.push_back(column.ToString());
+				}
+			}
+			snapshot.configuration.clear();
+			auto configuration = GetStructField(metadata, "configuration");
+			if (!configuration.IsNull()) {
+				for (auto &entry : MapValue::GetChildren(configuration)) {
+					auto &key_value = StructValue::GetChildren(entry);
+					snapshot.configuration[key_value[0].ToString()] = key_value[1].ToString();
+				}
+			}
+		}
+	}
+}
+
+void DeltaClassicLogReader::ApplyCommit(const string &contents, DeltaClassicSnapshot &snapshot,
+                                        unordered_map<string, DeltaClassicDataFile> &active_files) {
+	for (auto &line : StringUtil::Split(contents, '\n')) {
+		StringUtil::Trim(line);
+		if (line.empty()) {
+			continue;
+		}
+		auto action = DeltaClassicJsonValue::Parse(line);
+		if (auto add = action->Get("add")) {
+			auto file = ParseAddAction(*add);
+			active_files[file.path] = std::move(file);
+		} else if (auto remove = action->Get("remove")) {
+			active_files.erase(DecodePath(remove->GetString("path")));
+		} else if (auto metadata = action->Get("metaData")) {
+			ApplyMetadata(*metadata, snapshot);
+		}
+	}
+}
+
+shared_ptr<DeltaClassicSnapshot> DeltaClassicLogReader::ReadMetadata() {
+	auto listing = ListLog();
+	int64_t checkpoint_version = -1;
+	if (!listing.checkpoints.empty()) {
+		checkpoint_version = listing.checkpoints.rbegin()->first;
+	}
+	auto snapshot = make_shared_ptr<DeltaClassicSnapshot>();
+	snapshot->version = checkpoint_version;
+	if (!listing.commits.empty()) {
+		snapshot->version = MaxValue<int64_t>(snapshot->version, listing.commits.back());
+	}
+	if (snapshot->version < 0) {
+		throw IOException("No Delta log found at \"%s\"", log_path);
+	}
+
+	// Metadata rarely changes, so the newest commit that has a metaData action is usually the last one or the
+	// table's first commit; the checkpoint is only needed when the tail after it does not change the metadata.
+	// The tail is read newest first in parallel batches, so a long log without a checkpoint costs one round trip
+	// per max_threads commits rather than one per commit.
+	vector<int64_t> tail;
+	for (auto commit = listing.commits.rbegin(); commit != listing.commits.rend() && *commit > checkpoint_version;
+	     commit++) {
+		tail.push_back(*commit);
+	}
+	auto batch_size = MaxValue<idx_t>(max_threads, 1);
+	for (idx_t batch_start = 0; batch_start < tail.size(); batch_start += batch_size) {
+		auto batch_end = MinValue<idx_t>(batch_start + batch_size, tail.size());
+		vector<string> contents(batch_end - batch_start);
+		DeltaClassicParallel::ForEach(contents.size(), max_threads, [&](idx_t i) {
+			contents[i] = ReadFile(log_path + "/" + CommitFileName(tail[batch_start + i]));
+		});
+		for (auto &commit_contents : contents) {
+			for (auto &line : StringUtil::Split(commit_contents, '\n')) {
+				StringUtil::Trim(line);
+				if (line.empty()) {
+					continue;
+				}
+				auto action = DeltaClassicJsonValue::Parse(line);
+				if (auto metadata = action->Get("metaData")) {
+					ApplyMetadata(*metadata, *snapshot);
+					return snapshot;
+				}
+			}
+		}
+	}
+	if (checkpoint_version >= 0) {
+		ReadCheckpoint(listing.checkpoints[checkpoint_version], *snapshot, nullptr);
+	}
+	if (snapshot->schema_string.empty()) {
+		throw IOException("Delta log of \"%s\" has no metaData action", table_path);
+	}
+	return snapshot;
+}
+
+DeltaClassicChanges DeltaClassicLogReader::ReadChanges(int64_t from_version, int64_t to_version) {
+	DeltaClassicChanges result;
+	if (from_version > to_version) {
+		return result;
+	}
+	// Every commit in the range must be read from its JSON file; checkpoints only hold the resulting state
+	auto listing = ListLog();
+	if (listing.commits.empty() || to_version > listing.commits.back()) {
+		throw IOException("Version %lld of Delta table \"%s\" does not exist", to_version, table_path);
+	}
+	vector<int64_t> commits;
+	for (auto commit : listing.commits) {
+		if (commit >= from_version && commit <= to_version) {
+			commits.push_back(commit);
+		}
+	}
+	if (int64_t(commits.size()) != to_version - from_version + 1) {
+		throw IOException("Delta log of \"%s\" does not hold all commits from version %lld to %lld; older commits "
+		                  "may have been cleaned up",
+		                  table_path, from_version, to_version);
+	}
+
+	vector<string> commit_contents(commits.size());
+	DeltaClassicParallel::ForEach(commits.size(), max_threads, [&](idx_t i) {
+		commit_contents[i] = ReadFile(log_path + "/" + CommitFileName(commits[i]));
+	});
+	for (idx_t i = 0; i < commits.size(); i++) {
+		for (auto &line : StringUtil::Split(commit_contents[i], '\n')) {
+			StringUtil::Trim(line);
+			if (line.empty()) {
+				continue;
+			}
+			auto action = DeltaClassicJsonValue::Parse(line);
+			if (auto add = action->Get("add")) {
+				if (IsDataChange(*add)) {
+					result.added.push_back({commits[i], ParseAddAction(*add)});
+				}
+			} else if (auto remove = action->Get("remove")) {
+				if (IsDataChange(*remove)) {
+					DeltaClassicDataFile file;
+					file.path = DecodePath(remove->GetString("path"));
+					file.size = idx_t(MaxValue<int64_t>(remove->GetInteger("size", 0), 0));
+					result.removed.push_back({commits[i], std::move(file)});
+				}
+			}
+		}
+	}
+	return result;
+}
+
+shared_ptr<DeltaClassicSnapshot> DeltaClassicLogReader::ReadSnapshot(int64_t version) {
+	auto listing = ListLog();
+	int64_t latest = -1;
+	if (!listing.commits.empty()) {
+		latest = listing.commits.back();
+	}
+	if (!listing.checkpoints.empty()) {
+		latest = MaxValue<int64_t>(latest, listing.checkpoints.rbegin()->first);
+	}
+	if (latest < 0) {
+		throw IOException("No Delta log found at \"%s\"", log_path);
+	}
+	auto target = version < 0 ? latest : version;
+	if (target > latest) {
+		throw IOException("Version %lld of Delta table \"%s\" does not exist (latest is %lld)", target, table_path,
+		                  latest);
+	}
+
+	// Start from the newest checkpoint at or before the target, then replay the commits after it
+	int64_t checkpoint_version = -1;
+	for (auto &checkpoint : listing.checkpoints) {
+		if (checkpoint.first <= target) {
+			checkpoint_version = checkpoint.first;
+		}
+	}
+	vector<int64_t> replay;
+	for (auto commit : listing.commits) {
+		if (commit > checkpoint_version && commit <= target) {
+			replay.push_back(commit);
+		}
+	}
+	if (int64_t(replay.size()) != target - checkpoint_version) {
+		throw IOException("Delta log of \"%s\" is missing commits needed to reconstruct version %lld", table_path,
+		                  target);
+	}
+
+	auto snapshot = make_shared_ptr<DeltaClassicSnapshot>();
+	snapshot->version = target;
+	unordered_map<string, DeltaClassicDataFile> active_files;
+	if (checkpoint_version >= 0) {
+		ReadCheckpoint(listing.checkpoints[checkpoint_version], *snapshot, &active_files);
+	}
+
+	// Fetch the commit files concurrently, then apply them in order
+	vector<string> commit_contents(replay.size());
+	DeltaClassicParallel::ForEach(replay.size(), max_threads, [&](idx_t i) {
+		commit_contents[i] = ReadFile(log_path + "/" + CommitFileName(replay[i]));
+	});
+	for (auto &contents : commit_contents) {
+		ApplyCommit(contents, *snapshot, active_files);
+	}
+
+	for (auto &entry : active_files) {
+		snapshot->files.push_back(std::move(entry.second));
+	}
+	std::sort(snapshot->files.begin(), snapshot->files.end(),
+	          [](const DeltaClassicDataFile &a, const DeltaClassicDataFile &b) { return a.path < b.path; });
+	return snapshot;
+}
+
+} // namespace duckdb
@@ -0,0 +1,101 @@
+#include "storage/delta_classic_manifest.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/uuid.hpp"
+
+namespace duckdb {
+
+// Tab-separated text, one record per line:
+//   delta_classic_manifest <version> <base_path>
+//   listing <fingerprint>
+//   schema <name> <path> <tables_loaded> <fingerprint>
+//   table <name> <path>                      (belongs to the preceding schema)
+static constexpr const char *MANIFEST_MAGIC = "delta_classic_manifest";
+static constexpr const char *MANIFEST_VERSION = "1";
+
+string DeltaClassicManifest::GetPath(FileSystem &fs, const string &cache_dir, const string &base_path,
+                                     const DeltaClassicOptions &options) {
+	// Different discovery settings produce different listings of the same path
+	auto key = Hash(base_path.c_str(), base_path.size());
+	key = CombineHash(key, Hash(uint8_t(options.discovery_mode)));
+	for (auto &pattern : options.include_patterns) {
+		key = CombineHash(key, Hash(("+" + pattern).c_str(), pattern.size() + 1));
+	}
+	for (auto &pattern : options.exclude_patterns) {
+		key = CombineHash(key, Hash(("-" + pattern).c_str(), pattern.size() + 1));
+	}
+	return fs.JoinPath(cache_dir, "listing_" + std::to_string(key) + ".manifest");
+}
+
+bool DeltaClassicManifest::Read(FileSystem &fs, const string &manifest_path, const string &base_path,
+                                DeltaClassicListing &listing) {
+	if (!fs.FileExists(manifest_path)) {
+		return false;
+	}
+	auto handle = fs.OpenFile(manifest_path, FileFlags::FILE_FLAGS_READ);
+	auto file_size = handle->GetFileSize();
+	string contents(file_size, '\0');
+	handle->Read((void *)contents.data(), file_size);
+
+	auto lines = StringUtil::Split(contents, '\n');
+	if (lines.empty()) {
+		return false;
+	}
+	auto header = StringUtil::Split(lines[0], '\t');
+	if (header.size() != 3 || header[0] != MANIFEST_MAGIC || header[1] != MANIFEST_VERSION ||
+	    header[2] != base_path) {
+		return false;
+	}
+
+	DeltaClassicListing result;
+	for (idx_t i = 1; i < lines.size(); i++) {
+		auto fields = StringUtil::Split(lines[i], '\t');
+		if (fields.size() == 2 && fields[0] == "listing") {
+			result.fingerprint = std::stoull(fields[1]);
+		} else if (fields.size() == 5 && fields[0] == "schema") {
+			DeltaClassicDiscoveredSchema schema;
+			schema.name = fields[1];
+			schema.path = fields[2];
+			schema.tables_loaded = fields[3] == "1";
+			schema.fingerprint = std::stoull(fields[4]);
+			result.schemas.push_back(std::move(schema));
+		} else if (fields.size() == 3 && fields[0] == "table" && !result.schemas.empty()) {
+			result.schemas.back().tables.push_back(DeltaClassicDiscoveredTable {fields[1], fields[2]});
+		} else {
+			// Truncated or foreign file: fall back to a full discovery
+			return false;
+		}
+	}
+	listing = std::move(result);
+	return true;
+}
+
+void DeltaClassicManifest::Write(FileSystem &fs, const string &manifest_path, const string &base_path,
+                                 const DeltaClassicListing &listing) {
+	string contents;
+	contents += string(MANIFEST_MAGIC) + "\t" + MANIFEST_VERSION + "\t" + base_path + "\n";
+	contents += "listing\t" + std::to_string(listing.fingerprint) + "\n";
+	for (auto &schema : listing.schemas) {
+		contents += "schema\t" + schema.name + "\t" + schema.path + "\t" + (schema.tables_loaded ? "1" : "0") + "\t" +
+		            std::to_string(schema.fingerprint) + "\n";
+		for (auto &table : schema.tables) {
+			contents += "table\t" + table.name + "\t" + table.path + "\n";
+		}
+	}
+
+	auto cache_dir = manifest_path.substr(0, manifest_path.find_last_of("/\\"));
+	if (!fs.DirectoryExists(cache_dir)) {
+		fs.CreateDirectory(cache_dir);
+	}
+	// Write to a unique temporary file and rename, so concurrent attaches never read a partial manifest
+	auto temp_path = manifest_path + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp";
+	{
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write((void *)contents.data(), contents.size());
+		handle->Sync();
+	}
+	fs.MoveFile(temp_path, manifest_path);
+}
+
+} // namespace duckdb
@@ -0,0 +1,62 @@
+#include "storage/delta_classic_parallel.hpp"
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/mutex.hpp"
+
+#include <thread>
+
+namespace duckdb {
+
+void DeltaClassicParallel::ForEach(idx_t count, idx_t max_threads, const std::function<void(idx_t)> &task) {
+	if (count == 0) {
+		return;
+	}
+	auto thread_count = MinValue<idx_t>(MaxValue<idx_t>(max_threads, 1), count);
+	if (thread_count == 1) {
+		for (idx_t i = 0; i < count; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	atomic<idx_t> next_index(0);
+	atomic<bool> has_error(false);
+	mutex error_lock;
+	ErrorData error;
+
+	auto worker = [&]() {
+		while (!has_error) {
+			auto index = next_index++;
+			if (index >= count) {
+				return;
+			}
+			try {
+				task(index);
+			} catch (std::exception &ex) {
+				lock_guard<mutex> guard(error_lock);
+				if (!has_error) {
+					error = ErrorData(ex);
+					has_error = true;
+				}
+			}
+		}
+	};
+
+	vector<std::thread> threads;
+	threads.reserve(thread_count - 1);
+	for (idx_t i = 0; i + 1 < thread_count; i++) {
+		threads.emplace_back(worker);
+	}
+	// The calling thread participates as well
+	worker();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	if (has_error) {
+		error.Throw();
+	}
+}
+
+} // namespace duckdb
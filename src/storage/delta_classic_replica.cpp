@@ -0,0 +1,313 @@
+#include "storage/delta_classic_replica.hpp"
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_parallel.hpp"
+#include "storage/delta_classic_table_entry.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/enums/access_mode.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/parsed_data/attach_info.hpp"
+
+namespace duckdb {
+
+//! Schema and table of the replica database recording the version of every copy
+static constexpr const char *REPLICA_SCHEMA = "__delta_classic";
+static constexpr const char *REPLICA_TABLES = "tables";
+
+static string QuoteLiteral(const string &str) {
+	return "'" + StringUtil::Replace(str, "'", "''") + "'";
+}
+
+static unique_ptr<MaterializedQueryResult> Run(Connection &con, const string &sql) {
+	auto result = con.Query(sql);
+	if (result->HasError()) {
+		result->ThrowError();
+	}
+	return result;
+}
+
+static string FormatColumns(const ColumnList &columns) {
+	vector<string> result;
+	for (auto &column : columns.Logical()) {
+		result.push_back(KeywordHelper::WriteOptionallyQuoted(column.Name()) + " " + column.Type().ToString());
+	}
+	return StringUtil::Join(result, ", ");
+}
+
+DeltaClassicReplica::DeltaClassicReplica(string path, string db_name)
+    : path(std::move(path)), db_name(std::move(db_name)), attached(false) {
+}
+
+string DeltaClassicReplica::GetTableName(const string &schema_name, const string &table_name) const {
+	return KeywordHelper::WriteOptionallyQuoted(db_name) + "." + KeywordHelper::WriteOptionallyQuoted(schema_name) +
+	       "." + KeywordHelper::WriteOptionallyQuoted(table_name);
+}
+
+void DeltaClassicReplica::EnsureAttached(ClientContext &context) {
+	lock_guard<mutex> lock(attach_lock);
+	if (attached) {
+		return;
+	}
+	auto &db_manager = DatabaseManager::Get(context);
+	if (!db_manager.GetDatabase(context, db_name)) {
+		// Use the programmatic attach API (not context.Query which deadlocks during binding)
+		AttachInfo info;
+		info.name = db_name;
+		info.path = path;
+		info.on_conflict = OnCreateConflict::IGNORE_ON_CONFLICT;
+		unordered_map<string, Value> opts;
+		AttachOptions options(opts, AccessMode::READ_WRITE);
+		db_manager.AttachDatabase(context, info, options);
+		DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: attached replica '%s' as '%s'", path, db_name));
+	}
+
+	// The versions are read on a connection of its own: running a query on the binding client would deadlock
+	Connection con(DatabaseInstance::GetDatabase(context));
+	auto versions_table = GetTableName(REPLICA_SCHEMA, REPLICA_TABLES);
+	Run(con, "CREATE SCHEMA IF NOT EXISTS " + KeywordHelper::WriteOptionallyQuoted(db_name) + "." + REPLICA_SCHEMA);
+	Run(con, "CREATE TABLE IF NOT EXISTS " + versions_table +
+	             " (schema_name VARCHAR, table_name VARCHAR, table_path VARCHAR, version BIGINT, columns VARCHAR)");
+	auto result = Run(con, "SELECT schema_name, table_name, table_path, version, columns FROM " + versions_table);
+	lock_guard<mutex> tables_guard(tables_lock);
+	for (idx_t row = 0; row < result->RowCount(); row++) {
+		CopiedTable table;
+		table.schema_name = result->GetValue(0, row).ToString();
+		table.table_name = result->GetValue(1, row).ToString();
+		table.table_path = result->GetValue(2, row).ToString();
+		table.version = result->GetValue(3, row).GetValue<int64_t>();
+		table.columns = result->GetValue(4, row).ToString();
+		tables[GetTableName(table.schema_name, table.table_name)] = std::move(table);
+	}
+	attached = true;
+}
+
+optional_ptr<TableCatalogEntry> DeltaClassicReplica::GetTable(ClientContext &context, const string &schema_name,
+                                                              const string &table_name) {
+	try {
+		EnsureAttached(context);
+	} catch (std::exception &) {
+		// e.g. the file is locked by another process: tables are read from Delta
+		return nullptr;
+	}
+	{
+		lock_guard<mutex> lock(tables_lock);
+		if (tables.find(GetTableName(schema_name, table_name)) == tables.end()) {
+			return nullptr;
+		}
+	}
+	return Catalog::GetEntry<TableCatalogEntry>(context, db_name, schema_name, table_name,
+	                                            OnEntryNotFound::RETURN_NULL);
+}
+
+DeltaClassicReplicaResult DeltaClassicReplica::Sync(ClientContext &context,
+                                                    const vector<reference<DeltaClassicTableEntry>> &tables_p,
+                                                    idx_t max_threads, const atomic<bool> &stop) {
+	lock_guard<mutex> sync_guard(sync_lock);
+	EnsureAttached(context);
+	auto &db = DatabaseInstance::GetDatabase(context);
+
+	// Schemas are created up front, as concurrent transactions creating the same schema conflict
+	Connection con(db);
+	case_insensitive_set_t schema_names;
+	for (auto &table : tables_p) {
+		schema_names.insert(table.get().schema.name);
+	}
+	for (auto &schema_name : schema_names) {
+		Run(con, "CREATE SCHEMA IF NOT EXISTS " + KeywordHelper::WriteOptionallyQuoted(db_name) + "." +
+		             KeywordHelper::WriteOptionallyQuoted(schema_name));
+	}
+
+	// Each table is copied in a transaction of its own, so a failed or interrupted sync leaves every copy at a
+	// recorded version
+	vector<SyncOutcome> outcomes(tables_p.size(), SyncOutcome::UNCHANGED);
+	vector<string> errors(tables_p.size());
+	DeltaClassicParallel::ForEach(tables_p.size(), max_threads, [&](idx_t i) {
+		if (stop) {
+			return;
+		}
+		try {
+			outcomes[i] = SyncTable(db, tables_p[i], max_threads);
+		} catch (std::exception &ex) {
+			// The previous copy (if any) is kept and served; the next sync tries again
+			errors[i] = ErrorData(ex).Message();
+		}
+	});
+	DeltaClassicReplicaResult result;
+	for (idx_t i = 0; i < tables_p.size(); i++) {
+		result.tables_copied += outcomes[i] == SyncOutcome::COPIED;
+		result.tables_appended += outcomes[i] == SyncOutcome::APPENDED;
+		if (!errors[i].empty()) {
+			result.tables_failed++;
+			auto &table = tables_p[i].get();
+			DUCKDB_LOG_WARN(context, StringUtil::Format("delta_classic: replica failed to copy '%s': %s",
+			                                            table.delta_table_path, errors[i]));
+		}
+	}
+	if (stop) {
+		return result;
+	}
+
+	case_insensitive_set_t current;
+	for (auto &table : tables_p) {
+		current.insert(GetTableName(table.get().schema.name, table.get().name));
+	}
+	vector<CopiedTable> removed;
+	{
+		lock_guard<mutex> lock(tables_lock);
+		for (auto &entry : tables) {
+			if (current.find(entry.first) == current.end()) {
+				removed.push_back(entry.second);
+			}
+		}
+	}
+	for (auto &table : removed) {
+		try {
+			DropTable(db, table);
+			result.tables_dropped++;
+		} catch (std::exception &) {
+			// Dropped by the next sync; queries no longer reach the copy of a table that is gone
+		}
+	}
+	return result;
+}
+
+DeltaClassicReplica::SyncOutcome DeltaClassicReplica::SyncTable(DatabaseInstance &db, DeltaClassicTableEntry &table,
+                                                                idx_t max_threads) {
+	auto table_name = GetTableName(table.schema.name, table.name);
+	CopiedTable previous;
+	bool has_previous;
+	{
+		lock_guard<mutex> lock(tables_lock);
+		auto entry = tables.find(table_name);
+		has_previous = entry != tables.end() && entry->second.table_path == table.delta_table_path;
+		if (has_previous) {
+			previous = entry->second;
+		}
+	}
+	DeltaClassicLogReader reader(db, FileSystem::GetFileSystem(db), table.delta_table_path, max_threads);
+	auto latest_version = reader.GetLatestVersion();
+	if (has_previous && previous.version >= 0 && previous.version == latest_version) {
+		return SyncOutcome::UNCHANGED;
+	}
+
+	CopiedTable copy;
+	copy.schema_name = table.schema.name;
+	copy.table_name = table.name;
+	copy.table_path = table.delta_table_path;
+	copy.version = latest_version;
+	string sql;
+	auto outcome = SyncOutcome::COPIED;
+	idx_t file_count = 0;
+
+	// Commits that only added files are applied by appending those files
+	if (has_previous && previous.version >= 0 && !previous.columns.empty() && previous.version < latest_version) {
+		auto metadata = reader.ReadMetadata();
+		ColumnList columns;
+		if (!metadata->HasColumnMapping() && metadata->TryGetColumns(columns) &&
+		    FormatColumns(columns) == previous.columns) {
+			auto changes = reader.ReadChanges(previous.version + 1, latest_version);
+			bool only_added = changes.removed.empty();
+			for (auto &change : changes.added) {
+				only_added = only_added && !change.file.has_deletion_vector;
+			}
+			if (only_added) {
+				sql = "INSERT INTO " + table_name + " SELECT * EXCLUDE (_commit_version) FROM (" +
+				      metadata->GetFilesQuery(table.delta_table_path, columns, changes.added) + ")";
+				copy.columns = previous.columns;
+				outcome = SyncOutcome::APPENDED;
+				file_count = changes.added.size();
+			}
+		}
+	}
+	if (sql.empty()) {
+		auto snapshot = reader.ReadSnapshot(latest_version);
+		ColumnList columns;
+		bool readable = !snapshot->HasColumnMapping() && snapshot->TryGetColumns(columns);
+		for (auto &file : snapshot->files) {
+			readable = readable && !file.has_deletion_vector;
+		}
+		file_count = snapshot->files.size();
+		if (readable) {
+			vector<DeltaClassicFileChange> files;
+			for (auto &file : snapshot->files) {
+				files.push_back(DeltaClassicFileChange {snapshot->version, std::move(file)});
+			}
+			sql = "CREATE OR REPLACE TABLE " + table_name + " AS SELECT * EXCLUDE (_commit_version) FROM (" +
+			      snapshot->GetFilesQuery(table.delta_table_path, columns, files) + ")";
+			copy.columns = FormatColumns(columns);
+		} else {
+			// Deletion vectors and column mapping are applied by the delta extension. It reads the latest version,
+			// which is only recorded if no commit landed meanwhile; these copies are never appended to.
+			sql = "CREATE OR REPLACE TABLE " + table_name + " AS SELECT * FROM delta_scan(" +
+			      QuoteLiteral(table.delta_table_path) + ")";
+		}
+	}
+
+	Connection con(db);
+	con.BeginTransaction();
+	try {
+		Run(con, sql);
+		if (copy.columns.empty() && reader.GetLatestVersion() != latest_version) {
+			copy.version = -1;
+		}
+		auto versions_table = GetTableName(REPLICA_SCHEMA, REPLICA_TABLES);
+		Run(con, "DELETE FROM " + versions_table + " WHERE schema_name = " + QuoteLiteral(copy.schema_name) +
+		             " AND table_name = " + QuoteLiteral(copy.table_name));
+		Run(con, "INSERT INTO " + versions_table + " VALUES (" + QuoteLiteral(copy.schema_name) + ", " +
+		             QuoteLiteral(copy.table_name) + ", " + QuoteLiteral(copy.table_path) + ", " +
+		             std::to_string(copy.version) + ", " + QuoteLiteral(copy.columns) + ")");
+		con.Commit();
+	} catch (...) {
+		con.Rollback();
+		throw;
+	}
+	DUCKDB_LOG_INFO(*con.context,
+	                StringUtil::Format("delta_classic: replica %s %llu files of '%s' at version %lld",
+	                                   outcome == SyncOutcome::APPENDED ? "appended" : "copied", file_count,
+	                                   table.delta_table_path, latest_version));
+	lock_guard<mutex> lock(tables_lock);
+	tables[table_name] = std::move(copy);
+	return outcome;
+}
+
+void DeltaClassicReplica::DropTable(DatabaseInstance &db, const CopiedTable &table) {
+	auto table_name = GetTableName(table.schema_name, table.table_name);
+	Connection con(db);
+	con.BeginTransaction();
+	try {
+		Run(con, "DROP TABLE IF EXISTS " + table_name);
+		Run(con, "DELETE FROM " + GetTableName(REPLICA_SCHEMA, REPLICA_TABLES) +
+		             " WHERE schema_name = " + QuoteLiteral(table.schema_name) +
+		             " AND table_name = " + QuoteLiteral(table.table_name));
+		con.Commit();
+	} catch (...) {
+		con.Rollback();
+		throw;
+	}
+	lock_guard<mutex> lock(tables_lock);
+	tables.erase(table_name);
+}
+
+void DeltaClassicReplica::Detach(ClientContext &context) {
+	lock_guard<mutex> lock(attach_lock);
+	if (!attached) {
+		return;
+	}
+	DatabaseManager::Get(context).DetachDatabase(context, db_name, OnEntryNotFound::RETURN_NULL);
+	attached = false;
+	lock_guard<mutex> tables_guard(tables_lock);
+	tables.clear();
+}
+
+} // namespace duckdb
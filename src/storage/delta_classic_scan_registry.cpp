@@ -0,0 +1,185 @@
+#include "storage/delta_classic_scan_registry.hpp"
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_table_entry.hpp"
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/node_statistics.hpp"
+
+namespace duckdb {
+
+static constexpr const char *SCAN_REGISTRY_KEY = "delta_classic_scans";
+
+//! What EXPLAIN and the profiler show for a wrapped scan, together with the delegated scan's to_string
+struct DeltaClassicScanDescription {
+	table_function_to_string_t delegate_to_string = nullptr;
+	string delta_table_path;
+	//! The snapshot the scan reads, or nullptr if it is not known
+	shared_ptr<DeltaClassicSnapshot> snapshot;
+};
+
+//! The to_string callback gets no client context to find a registry by. Descriptions are instead keyed by the scan
+//! function's function_info, which the scan and every copy of it share: the key cannot be reused by another scan
+//! while the entry exists, and the entry goes away with the last plan holding the scan.
+using scan_description_map_t = map<weak_ptr<TableFunctionInfo>, DeltaClassicScanDescription,
+                                   std::owner_less<weak_ptr<TableFunctionInfo>>>;
+static mutex scan_descriptions_lock;
+static scan_description_map_t scan_descriptions;
+
+static unique_ptr<NodeStatistics> DeltaClassicScanCardinality(ClientContext &context, const FunctionData *bind_data) {
+	auto scan = DeltaClassicScanRegistry::Lookup(context, bind_data);
+	if (scan.table) {
+		auto result = scan.table->GetCardinality(context, *scan.internal_table);
+		if (result) {
+			return result;
+		}
+	}
+	auto delegate = scan.delegate_cardinality;
+	return delegate ? delegate(context, bind_data) : nullptr;
+}
+
+static unique_ptr<BaseStatistics> DeltaClassicScanStatistics(ClientContext &context, const FunctionData *bind_data,
+                                                             column_t column_index) {
+	auto scan = DeltaClassicScanRegistry::Lookup(context, bind_data);
+	if (scan.table) {
+		auto result = scan.table->GetScanStatistics(context, *scan.internal_table, column_index);
+		if (result) {
+			return result;
+		}
+	}
+	auto delegate = scan.delegate_statistics;
+	return delegate ? delegate(context, bind_data, column_index) : nullptr;
+}
+
+static InsertionOrderPreservingMap<string> DeltaClassicScanToString(TableFunctionToStringInput &input) {
+	DeltaClassicScanDescription description;
+	{
+		lock_guard<mutex> guard(scan_descriptions_lock);
+		auto entry = scan_descriptions.find(input.table_function.function_info);
+		if (entry == scan_descriptions.end()) {
+			return InsertionOrderPreservingMap<string>();
+		}
+		description = entry->second;
+	}
+	InsertionOrderPreservingMap<string> result;
+	if (description.delegate_to_string) {
+		result = description.delegate_to_string(input);
+	}
+	// Shown in EXPLAIN and in the profiler output of the scan
+	result["Delta Table"] = description.delta_table_path;
+	auto &snapshot = description.snapshot;
+	if (snapshot) {
+		result["Delta Version"] = std::to_string(snapshot->version);
+		result["Delta Files"] = std::to_string(snapshot->files.size());
+		result["Delta Bytes"] = std::to_string(snapshot->GetTotalSize());
+	}
+	return result;
+}
+
+DeltaClassicScanRegistry &DeltaClassicScanRegistry::Get(ClientContext &context) {
+	return *context.registered_state->GetOrCreate<DeltaClassicScanRegistry>(SCAN_REGISTRY_KEY);
+}
+
+DeltaClassicBoundScan DeltaClassicScanRegistry::Lookup(ClientContext &context, const FunctionData *bind_data) {
+	auto registry = context.registered_state->Get<DeltaClassicScanRegistry>(SCAN_REGISTRY_KEY);
+	if (!registry) {
+		return DeltaClassicBoundScan();
+	}
+	lock_guard<mutex> guard(registry->lock);
+	DeltaClassicBoundScan result;
+	auto entry = registry->scans.find(bind_data);
+	if (entry != registry->scans.end()) {
+		result = entry->second;
+	}
+	result.delegate_cardinality = registry->delegate_cardinality;
+	result.delegate_statistics = registry->delegate_statistics;
+	return result;
+}
+
+void DeltaClassicScanRegistry::WrapScanFunction(ClientContext &context, TableFunction &function,
+                                                DeltaClassicTableEntry &table, TableCatalogEntry &internal_table) {
+	DeltaClassicScanDescription description;
+	description.delta_table_path = table.delta_table_path;
+	description.snapshot = table.GetScanSnapshot(context, internal_table);
+	{
+		lock_guard<mutex> guard(lock);
+		if (function.cardinality != DeltaClassicScanCardinality) {
+			delegate_cardinality = function.cardinality;
+			function.cardinality = DeltaClassicScanCardinality;
+		}
+		if (function.statistics != DeltaClassicScanStatistics) {
+			delegate_statistics = function.statistics;
+			function.statistics = DeltaClassicScanStatistics;
+		}
+	}
+	if (function.to_string != DeltaClassicScanToString) {
+		description.delegate_to_string = function.to_string;
+		function.to_string = DeltaClassicScanToString;
+	}
+	if (!function.function_info) {
+		// Only serves as the key of the description
+		function.function_info = make_shared_ptr<TableFunctionInfo>();
+	}
+	{
+		lock_guard<mutex> guard(scan_descriptions_lock);
+		scan_descriptions[function.function_info] = std::move(description);
+	}
+	lock_guard<mutex> guard(lock);
+	described_functions.push_back(function.function_info);
+}
+
+void DeltaClassicScanRegistry::Register(ClientContext &context, const FunctionData &bind_data,
+                                        DeltaClassicTableEntry &table, TableCatalogEntry &internal_table) {
+	DeltaClassicBoundScan scan;
+	scan.table = &table;
+	scan.internal_table = &internal_table;
+	scan.snapshot = table.GetScanSnapshot(context, internal_table);
+	lock_guard<mutex> guard(lock);
+	// A bind data address of an earlier bind in this query may be reused once that bind data is freed
+	scans[&bind_data] = std::move(scan);
+}
+
+void DeltaClassicScanRegistry::Use(DeltaClassicTableEntry &table) {
+	table.AcquireScan();
+	lock_guard<mutex> guard(lock);
+	used_tables.push_back(table);
+}
+
+void DeltaClassicScanRegistry::QueryEnd() {
+	lock_guard<mutex> guard(lock);
+	for (auto &scan : scans) {
+		auto &snapshot = scan.second.snapshot;
+		if (snapshot) {
+			auto &stats = scan.second.table->stats;
+			stats.Record(stats.scanned_table_bytes, snapshot->GetTotalSize());
+		}
+	}
+	scans.clear();
+	for (auto &table : used_tables) {
+		table.get().ReleaseScan();
+	}
+	used_tables.clear();
+	RemoveExpiredDescriptions();
+}
+
+void DeltaClassicScanRegistry::RemoveExpiredDescriptions() {
+	// Only the descriptions of this client's scans are checked, so no bind sweeps the map of the whole process.
+	// Plans that outlive the query (prepared statements) keep theirs until a later query ends after them.
+	lock_guard<mutex> guard(scan_descriptions_lock);
+	for (auto entry = described_functions.begin(); entry != described_functions.end();) {
+		if (!entry->expired()) {
+			entry++;
+			continue;
+		}
+		scan_descriptions.erase(*entry);
+		entry = described_functions.erase(entry);
+	}
+}
+
+DeltaClassicScanRegistry::~DeltaClassicScanRegistry() {
+	lock_guard<mutex> guard(lock);
+	RemoveExpiredDescriptions();
+}
+
+} // namespace duckdb
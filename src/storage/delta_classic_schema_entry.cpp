@@ -4,6 +4,7 @@
 #include "duckdb/catalog/catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/exception/binder_exception.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 
 namespace duckdb {
@@ -86,6 +87,22 @@ void DeltaClassicSchemaEntry::Scan(CatalogType type, const std::function<void(Ca
 	tables.ScanNoContext(callback);
 }
 
+SimilarCatalogEntry DeltaClassicSchemaEntry::GetSimilarEntry(CatalogTransaction transaction,
+                                                             const EntryLookupInfo &lookup_info) {
+	SimilarCatalogEntry result;
+	if (lookup_info.GetCatalogType() != CatalogType::TABLE_ENTRY || !transaction.HasContext()) {
+		return result;
+	}
+	tables.ScanNames(transaction.GetContext(), [&](const string &name) {
+		auto score = StringUtil::SimilarityRating(name, lookup_info.GetEntryName());
+		if (score > result.score) {
+			result.score = score;
+			result.name = name;
+		}
+	});
+	return result;
+}
+
 void DeltaClassicSchemaEntry::DropEntry(ClientContext &context, DropInfo &info) {
 	throw BinderException("delta_classic databases are read-only");
 }
@@ -0,0 +1,211 @@
+#include "storage/delta_classic_snapshot_registry.hpp"
+
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+static int64_t SteadyClockMicros() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+DeltaClassicSnapshotRegistry::DeltaClassicSnapshotRegistry() : expiry(make_shared_ptr<ExpiryState>()) {
+}
+
+DeltaClassicSnapshotRegistry::~DeltaClassicSnapshotRegistry() {
+	{
+		lock_guard<mutex> guard(expiry->lock);
+		expiry->stop = true;
+	}
+	expiry->cv.notify_all();
+	if (!expiry_thread.joinable()) {
+		return;
+	}
+	if (expiry_thread.get_id() == std::this_thread::get_id()) {
+		// The expiry thread dropped the last reference to the database instance; it exits without touching the
+		// registry again
+		expiry_thread.detach();
+	} else {
+		expiry_thread.join();
+	}
+}
+
+string DeltaClassicSnapshotRegistry::GetSharedKey(const string &table_path, int64_t version) {
+	return table_path + "@" + std::to_string(version);
+}
+
+string DeltaClassicSnapshotRegistry::Reserve(const string &base_name) {
+	lock_guard<mutex> guard(lock);
+	// The base name is taken while another catalog still shares a database attached under it, or while a
+	// replaced generation of the same table is attached
+	auto db_name = base_name;
+	for (idx_t suffix = 1; databases.find(db_name) != databases.end(); suffix++) {
+		db_name = base_name + "@" + std::to_string(suffix);
+	}
+	databases[db_name].references = 1;
+	return db_name;
+}
+
+void DeltaClassicSnapshotRegistry::Share(const string &db_name, const string &table_path, int64_t version) {
+	lock_guard<mutex> guard(lock);
+	auto key = GetSharedKey(table_path, version);
+	auto entry = databases.find(db_name);
+	if (entry == databases.end() || shared_databases.find(key) != shared_databases.end()) {
+		// Two catalogs attached the same version at the same time: later ones share the first
+		return;
+	}
+	entry->second.shared_key = key;
+	shared_databases[key] = db_name;
+}
+
+string DeltaClassicSnapshotRegistry::Acquire(const string &table_path, int64_t version) {
+	lock_guard<mutex> guard(lock);
+	auto shared = shared_databases.find(GetSharedKey(table_path, version));
+	if (shared == shared_databases.end()) {
+		return string();
+	}
+	auto &entry = databases[shared->second];
+	if (entry.handed_off) {
+		// Take over the reference the detached catalog left behind
+		entry.handed_off = false;
+	} else {
+		entry.references++;
+	}
+	return shared->second;
+}
+
+void DeltaClassicSnapshotRegistry::Release(ClientContext &context, const string &db_name) {
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = databases.find(db_name);
+		if (entry == databases.end() || entry->second.detaching || --entry->second.references > 0) {
+			return;
+		}
+		if (!entry->second.shared_key.empty()) {
+			shared_databases.erase(entry->second.shared_key);
+		}
+		// Keeps Reserve from handing out the name before the database is gone, without holding the lock while
+		// detaching: catalogs detach their tables' databases concurrently
+		entry->second.detaching = true;
+	}
+	try {
+		DatabaseManager::Get(context).DetachDatabase(context, db_name, OnEntryNotFound::RETURN_NULL);
+	} catch (...) {
+		lock_guard<mutex> guard(lock);
+		databases.erase(db_name);
+		throw;
+	}
+	lock_guard<mutex> guard(lock);
+	databases.erase(db_name);
+}
+
+bool DeltaClassicSnapshotRegistry::HandOff(ClientContext &context, const string &db_name, int64_t timeout) {
+	bool handed_off = false;
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = databases.find(db_name);
+		// Only a shared database (at a known version) can be taken over; one handed off reference is enough
+		if (entry != databases.end() && !entry->second.detaching && !entry->second.shared_key.empty() &&
+		    !entry->second.handed_off) {
+			entry->second.handed_off = true;
+			entry->second.handoff_expires_at = SteadyClockMicros() + timeout;
+			handed_off = true;
+		}
+	}
+	if (!handed_off) {
+		Release(context, db_name);
+		return false;
+	}
+	StartExpiry(DatabaseInstance::GetDatabase(context));
+	return true;
+}
+
+void DeltaClassicSnapshotRegistry::ExpireHandOffs(ClientContext &context) {
+	vector<string> expired;
+	{
+		lock_guard<mutex> guard(lock);
+		auto now = SteadyClockMicros();
+		for (auto &entry : databases) {
+			if (entry.second.handed_off && entry.second.handoff_expires_at <= now) {
+				entry.second.handed_off = false;
+				expired.push_back(entry.first);
+			}
+		}
+	}
+	for (auto &db_name : expired) {
+		Release(context, db_name);
+	}
+}
+
+int64_t DeltaClassicSnapshotRegistry::NextHandOffDeadline() {
+	lock_guard<mutex> guard(lock);
+	int64_t result = -1;
+	for (auto &entry : databases) {
+		if (entry.second.handed_off && (result < 0 || entry.second.handoff_expires_at < result)) {
+			result = entry.second.handoff_expires_at;
+		}
+	}
+	return result;
+}
+
+void DeltaClassicSnapshotRegistry::StartExpiry(DatabaseInstance &db) {
+	lock_guard<mutex> guard(expiry->lock);
+	if (expiry->stop) {
+		return;
+	}
+	expiry->wake = true;
+	if (expiry_thread.joinable()) {
+		expiry->cv.notify_all();
+		return;
+	}
+	// A weak reference, so the thread never keeps a closed database instance alive
+	expiry->db = db.shared_from_this();
+	expiry_thread = std::thread([this, state = expiry]() { RunExpiry(state); });
+}
+
+void DeltaClassicSnapshotRegistry::RunExpiry(shared_ptr<ExpiryState> state) {
+	// The registry belongs to the database instance, so it is only used while the instance is held
+	while (true) {
+		int64_t deadline;
+		{
+			auto db = state->db.lock();
+			if (!db) {
+				return;
+			}
+			deadline = NextHandOffDeadline();
+		}
+		{
+			unique_lock<mutex> guard(state->lock);
+			auto woken = [&]() {
+				return state->stop || state->wake;
+			};
+			if (deadline < 0) {
+				state->cv.wait(guard, woken);
+			} else {
+				state->cv.wait_for(guard, std::chrono::microseconds(deadline - SteadyClockMicros()), woken);
+			}
+			if (state->stop) {
+				return;
+			}
+			state->wake = false;
+		}
+		auto db = state->db.lock();
+		if (!db) {
+			return;
+		}
+		try {
+			Connection con(*db);
+			auto &context = *con.context;
+			context.RunFunctionInTransaction([&]() { ExpireHandOffs(context); });
+		} catch (std::exception &) {
+			// Retried at the next deadline, and by the next attach or detach of a catalog
+		}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,109 @@
+#include "storage/delta_classic_stats.hpp"
+
+#include "duckdb/common/limits.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+static idx_t BitWidth(idx_t value) {
+	idx_t width = 0;
+	for (; value > 0; value >>= 1) {
+		width++;
+	}
+	return width;
+}
+
+void DeltaClassicHistogram::Record(idx_t value) {
+	if (count == 0 || value < min) {
+		min = value;
+	}
+	if (value > max) {
+		max = value;
+	}
+	count++;
+	total += value;
+	buckets[BitWidth(value)]++;
+}
+
+idx_t DeltaClassicHistogram::Quantile(double quantile) const {
+	if (count == 0) {
+		return 0;
+	}
+	// The rank of the value at the quantile, counting from 1
+	auto rank = MaxValue<idx_t>(idx_t(quantile * double(count) + 0.5), 1);
+	idx_t seen = 0;
+	for (idx_t i = 0; i < BUCKET_COUNT; i++) {
+		seen += buckets[i];
+		if (seen >= rank) {
+			auto upper_bound = i == 0 ? 0 : i >= 64 ? NumericLimits<idx_t>::Maximum() : (idx_t(1) << i) - 1;
+			return MinValue(upper_bound, max);
+		}
+	}
+	return max;
+}
+
+void DeltaClassicStats::Record(DeltaClassicHistogram &histogram, idx_t value) {
+	lock_guard<mutex> guard(lock);
+	histogram.Record(value);
+}
+
+vector<DeltaClassicMetric> DeltaClassicStats::GetMetrics() {
+	vector<DeltaClassicMetric> result;
+	auto add_histogram = [&](const char *name, const char *unit, const DeltaClassicHistogram &histogram) {
+		if (histogram.count == 0) {
+			return;
+		}
+		DeltaClassicMetric metric;
+		metric.name = name;
+		metric.unit = unit;
+		metric.count = histogram.count;
+		metric.is_histogram = true;
+		metric.total = histogram.total;
+		metric.min = histogram.min;
+		metric.max = histogram.max;
+		metric.p50 = histogram.Quantile(0.5);
+		metric.p99 = histogram.Quantile(0.99);
+		result.push_back(std::move(metric));
+	};
+	auto add_counter = [&](const char *name, const char *unit, idx_t count) {
+		if (count == 0) {
+			return;
+		}
+		DeltaClassicMetric metric;
+		metric.name = name;
+		metric.unit = unit;
+		metric.count = count;
+		result.push_back(std::move(metric));
+	};
+
+	{
+		lock_guard<mutex> guard(lock);
+		add_histogram("discovery", "us", discovery);
+		add_histogram("list_tables", "us", list_tables);
+		add_histogram("probe", "us", probe);
+		add_histogram("attach", "us", attach);
+		add_histogram("scanned_table_bytes", "bytes", scanned_table_bytes);
+	}
+	add_counter("list_calls", "calls", list_calls);
+	add_counter("exists_calls", "calls", exists_calls);
+	add_counter("binds", "calls", binds);
+	add_counter("storage_read_bytes", "bytes", storage_read_bytes);
+	add_counter("cache_read_bytes", "bytes", cache_read_bytes);
+	return result;
+}
+
+int64_t DeltaClassicStats::Now() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+DeltaClassicTimer::DeltaClassicTimer(DeltaClassicStats &stats, DeltaClassicHistogram &histogram)
+    : stats(stats), histogram(histogram), start(DeltaClassicStats::Now()) {
+}
+
+DeltaClassicTimer::~DeltaClassicTimer() {
+	stats.Record(histogram, idx_t(DeltaClassicStats::Now() - start));
+}
+
+} // namespace duckdb
@@ -1,11 +1,22 @@
 #include "storage/delta_classic_table_entry.hpp"
+#include "storage/delta_classic_cache_file_system.hpp"
+#include "storage/delta_classic_cached_scan.hpp"
 #include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_key_index.hpp"
+#include "storage/delta_classic_log_reader.hpp"
+#include "storage/delta_classic_replica.hpp"
+#include "storage/delta_classic_scan_registry.hpp"
+#include "storage/delta_classic_snapshot_registry.hpp"
+#include "storage/delta_classic_transaction.hpp"
 
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/entry_lookup_info.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/exception/binder_exception.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "duckdb/main/database_manager.hpp"
 #include "duckdb/main/config.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
@@ -13,66 +24,561 @@
 #include "duckdb/storage/table_storage_info.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
 #include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/storage/statistics/node_statistics.hpp"
+
+#include <chrono>
 
 namespace duckdb {
 
+static int64_t SteadyClockMicros() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
 DeltaClassicTableEntry::DeltaClassicTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info,
                                                const string &delta_table_path)
-    : TableCatalogEntry(catalog, schema, info), delta_table_path(delta_table_path), is_attached(false) {
+    : TableCatalogEntry(catalog, schema, info), delta_table_path(delta_table_path), generation(0), attached_at(0),
+      refresh_pending(false), is_attached(false), cached_internal_table(nullptr), active_scans(0), last_used(0),
+      columns_loaded(false), columns_synced(false), pinned_version(-1), snapshot_failed(false),
+      materialized_version(-1), materialize_flight_version(-1), materialized_last_used(0) {
 	// Generate a unique internal database name to avoid collisions
 	internal_db_name = "__dc_" + catalog.GetName() + "_" + schema.name + "_" + info.table;
 }
 
 unique_ptr<BaseStatistics> DeltaClassicTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
-	return nullptr;
+	auto scanned_table = cached_internal_table.load();
+	if (!scanned_table) {
+		return nullptr;
+	}
+	return GetScanStatistics(context, *scanned_table, column_id);
+}
+
+unique_ptr<BaseStatistics> DeltaClassicTableEntry::GetScanStatistics(ClientContext &context,
+                                                                     TableCatalogEntry &scanned_table,
+                                                                     column_t column_id) {
+	// Min/max values drive filter pruning, so they are only exposed when they describe exactly what is scanned
+	auto current = GetScanSnapshot(context, scanned_table);
+	if (!current || column_id >= columns.LogicalColumnCount()) {
+		return nullptr;
+	}
+	auto &column = columns.GetColumn(LogicalIndex(column_id));
+	return current->GetColumnStatistics(column.Name(), column.Type());
+}
+
+shared_ptr<DeltaClassicSnapshot> DeltaClassicTableEntry::GetSnapshot(ClientContext &context) {
+	lock_guard<mutex> lock(snapshot_lock);
+	if (snapshot || snapshot_failed) {
+		return snapshot;
+	}
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	try {
+		DeltaClassicLogReader reader(DatabaseInstance::GetDatabase(context), FileSystem::GetFileSystem(context),
+		                             delta_table_path, dc_catalog.options.discovery_threads);
+		snapshot = reader.ReadSnapshot(pinned_version);
+	} catch (std::exception &) {
+		// Statistics are an optimization: without them the optimizer falls back to the delta scan's estimates
+		snapshot_failed = true;
+	}
+	return snapshot;
+}
+
+shared_ptr<DeltaClassicSnapshot> DeltaClassicTableEntry::GetScanSnapshot(ClientContext &context,
+                                                                         TableCatalogEntry &scanned_table) {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (dc_catalog.options.pin_snapshot || dc_catalog.options.as_of) {
+		auto current = GetSnapshot(context);
+		return current && SnapshotMatchesScan(scanned_table, *current) ? current : nullptr;
+	}
+	// The version the transaction's first bind scans; unknown if the scan is not that bind's internal table
+	auto &transaction_table = DeltaClassicTransaction::Get(context, catalog).GetTable(*this);
+	auto scan_version = transaction_table.scan_version;
+	if (scan_version < 0 || transaction_table.internal_table.get() != &scanned_table) {
+		return nullptr;
+	}
+	return GetSnapshotAt(context, scan_version);
+}
+
+shared_ptr<DeltaClassicSnapshot> DeltaClassicTableEntry::GetRewriteSnapshot(ClientContext &context,
+                                                                            TableCatalogEntry &scanned_table) {
+	auto result = GetScanSnapshot(context, scanned_table);
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (result || dc_catalog.options.pin_snapshot || dc_catalog.options.as_of) {
+		return result;
+	}
+	auto &transaction_table = DeltaClassicTransaction::Get(context, catalog).GetTable(*this);
+	if (transaction_table.scan_version >= 0 || transaction_table.internal_table.get() != &scanned_table ||
+	    !context.transaction.IsAutoCommit()) {
+		return nullptr;
+	}
+	// The scan opens whatever version is latest when it binds; a rewrite replacing it answers from the version
+	// that is latest now, which no other statement of the transaction can tell apart
+	auto latest_version = TryGetLatestVersion(context);
+	if (latest_version < 0) {
+		return nullptr;
+	}
+	return GetSnapshotAt(context, latest_version);
+}
+
+shared_ptr<DeltaClassicSnapshot> DeltaClassicTableEntry::GetSnapshotAt(ClientContext &context, int64_t version) {
+	{
+		lock_guard<mutex> lock(snapshot_lock);
+		if (snapshot && snapshot->version == version) {
+			return snapshot;
+		}
+	}
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	try {
+		DeltaClassicLogReader reader(DatabaseInstance::GetDatabase(context), FileSystem::GetFileSystem(context),
+		                             delta_table_path, dc_catalog.options.discovery_threads);
+		auto result = reader.ReadSnapshot(version);
+		lock_guard<mutex> lock(snapshot_lock);
+		snapshot = result;
+		snapshot_failed = false;
+		return result;
+	} catch (std::exception &) {
+		return nullptr;
+	}
+}
+
+unique_ptr<NodeStatistics> DeltaClassicTableEntry::GetCardinality(ClientContext &context,
+                                                                  TableCatalogEntry &scanned_table) {
+	auto current = GetScanSnapshot(context, scanned_table);
+	bool exact = current != nullptr;
+	if (!current) {
+		current = GetSnapshot(context);
+	}
+	if (!current) {
+		return nullptr;
+	}
+	auto row_count = current->GetRowCount();
+	if (!row_count.IsValid()) {
+		return nullptr;
+	}
+	if (exact) {
+		return make_uniq<NodeStatistics>(row_count.GetIndex(), row_count.GetIndex());
+	}
+	return make_uniq<NodeStatistics>(row_count.GetIndex());
+}
+
+bool DeltaClassicTableEntry::SnapshotMatchesScan(TableCatalogEntry &scanned_table,
+                                                 const DeltaClassicSnapshot &current) {
+	// A scan bound before RefreshSnapshot switched to a newer version still reads the replaced table. With
+	// AS_OF_TIMESTAMP every scan reads the same version.
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	lock_guard<mutex> lock(snapshot_lock);
+	return pinned_version >= 0 && current.version == pinned_version &&
+	       (dc_catalog.options.as_of || cached_internal_table.load() == &scanned_table);
+}
+
+int64_t DeltaClassicTableEntry::TryGetLatestVersion(ClientContext &context) {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	try {
+		DeltaClassicLogReader reader(DatabaseInstance::GetDatabase(context), FileSystem::GetFileSystem(context),
+		                             delta_table_path, dc_catalog.options.discovery_threads);
+		return reader.GetLatestVersion();
+	} catch (std::exception &) {
+		return -1;
+	}
+}
+
+void DeltaClassicTableEntry::Prewarm(ClientContext &context) {
+	EnsureAttached(context);
 }
 
 void DeltaClassicTableEntry::EnsureAttached(ClientContext &context) {
+	// Fast path once attached: no lock
 	if (is_attached) {
 		return;
 	}
 
-	auto &db_manager = DatabaseManager::Get(context);
+	// Single flight: the first caller attaches, callers arriving meanwhile (e.g. binds while PREWARM attaches
+	// the table) wait for that attach instead of starting their own
+	std::promise<void> attach_promise;
+	std::shared_future<void> flight;
+	bool is_leader = false;
+	{
+		lock_guard<mutex> lock(attach_lock);
+		if (is_attached) {
+			return;
+		}
+		if (!attach_flight.valid()) {
+			attach_flight = attach_promise.get_future().share();
+			is_leader = true;
+		}
+		flight = attach_flight;
+	}
+	if (!is_leader) {
+		try {
+			flight.get();
+		} catch (std::exception &ex) {
+			// Every waiter throws its own copy of the leader's error
+			ErrorData(ex).Throw();
+		}
+		return;
+	}
+
+	string db_name;
+	try {
+		DeltaClassicTimer timer(stats, stats.attach);
+		auto version = AttachInternalDatabase(context, internal_db_name, db_name);
+		if (version >= 0) {
+			lock_guard<mutex> lock(snapshot_lock);
+			pinned_version = version;
+			if (snapshot && snapshot->version != pinned_version) {
+				snapshot.reset();
+			}
+		}
+		attached_at = SteadyClockMicros();
+		// Binds waiting for the attach find the footers cached
+		PrefetchFooters(context);
+	} catch (...) {
+		// The next caller tries again
+		lock_guard<mutex> lock(attach_lock);
+		attach_flight = std::shared_future<void>();
+		attach_promise.set_exception(std::current_exception());
+		throw;
+	}
+	{
+		lock_guard<mutex> lock(attach_lock);
+		current_db_name = db_name;
+		is_attached = true;
+		attach_flight = std::shared_future<void>();
+		attach_promise.set_value();
+	}
+	catalog.Cast<DeltaClassicCatalog>().OnTableAttached(context, *this);
+}
+
+void DeltaClassicTableEntry::AcquireScan() {
+	active_scans++;
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (dc_catalog.options.max_attached_tables > 0) {
+		last_used = dc_catalog.NextUseTick();
+	}
+}
+
+void DeltaClassicTableEntry::ReleaseScan() {
+	active_scans--;
+}
 
-	// Check if already attached (e.g. from a previous call)
-	if (db_manager.GetDatabase(context, internal_db_name)) {
+bool DeltaClassicTableEntry::TryEvict(ClientContext &context) {
+	lock_guard<mutex> lock(attach_lock);
+	if (!is_attached || attach_flight.valid()) {
+		return false;
+	}
+	// Unpublish first, then check for scans: a bind increments active_scans before it reads either of these,
+	// so it either sees them cleared (and takes the slow path, waiting on attach_lock) or is seen here
+	auto cached_table = cached_internal_table.exchange(nullptr);
+	is_attached = false;
+	if (active_scans > 0) {
+		cached_internal_table = cached_table;
 		is_attached = true;
+		return false;
+	}
+
+	ReleaseInternalDatabases(context);
+	return true;
+}
+
+bool DeltaClassicTableEntry::DetachInternalDatabases(ClientContext &context) {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	lock_guard<mutex> lock(attach_lock);
+	cached_internal_table = nullptr;
+	bool handed_off = false;
+	if (dc_catalog.options.handoff > 0 && !current_db_name.empty()) {
+		handed_off = dc_catalog.snapshots.HandOff(context, current_db_name, dc_catalog.options.handoff);
+		current_db_name.clear();
+	}
+	ReleaseInternalDatabases(context);
+	return handed_off;
+}
+
+void DeltaClassicTableEntry::ReleaseInternalDatabases(ClientContext &context) {
+	auto &snapshots = catalog.Cast<DeltaClassicCatalog>().snapshots;
+	is_attached = false;
+	internal_db.reset();
+	columns_synced = false;
+	catalog.Cast<DeltaClassicCatalog>().DropMaterialized(*this);
+	{
+		// A later attach pins whatever version is latest by then
+		lock_guard<mutex> snapshot_guard(snapshot_lock);
+		pinned_version = -1;
+		snapshot.reset();
+		snapshot_failed = false;
+	}
+	if (!current_db_name.empty()) {
+		snapshots.Release(context, current_db_name);
+		current_db_name.clear();
+	}
+	for (auto &name : replaced_db_names) {
+		snapshots.Release(context, name);
+	}
+	replaced_db_names.clear();
+}
+
+void DeltaClassicTableEntry::PrefetchFooters(ClientContext &context) {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (!dc_catalog.options.prefetch_footers || !dc_catalog.cache_file_system) {
+		return;
+	}
+	auto current = GetSnapshot(context);
+	if (!current) {
 		return;
 	}
+	vector<string> paths;
+	for (auto &file : current->files) {
+		paths.push_back(DeltaClassicSnapshot::GetAbsolutePath(delta_table_path, file.path));
+	}
+	auto cached = dc_catalog.cache_file_system->PrefetchFooters(paths, dc_catalog.options.discovery_threads);
+	DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: prefetched %llu of %llu footers of '%s'", cached,
+	                                            paths.size(), delta_table_path));
+}
 
-	// Use the programmatic attach API (not context.Query which deadlocks during binding)
-	AttachInfo info;
-	info.name = internal_db_name;
-	info.path = delta_table_path;
-	info.on_conflict = OnCreateConflict::IGNORE_ON_CONFLICT;
+void DeltaClassicTableEntry::ScheduleRefreshIfStale() {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	auto max_staleness = dc_catalog.options.max_staleness;
+	if (max_staleness <= 0 || SteadyClockMicros() - attached_at < max_staleness) {
+		return;
+	}
+	// Only one refresh per table at a time; binds keep using the current snapshot meanwhile
+	if (!refresh_pending.exchange(true)) {
+		dc_catalog.ScheduleSnapshotRefresh(*this);
+	}
+}
 
-	unordered_map<string, Value> opts;
-	opts["type"] = Value("delta");
+void DeltaClassicTableEntry::RefreshSnapshot(ClientContext &context) {
 	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
-	if (dc_catalog.pin_snapshot) {
-		opts["pin_snapshot"] = Value::BOOLEAN(true);
+	try {
+		string base_name;
+		int64_t current_version;
+		{
+			lock_guard<mutex> lock(attach_lock);
+			if (!is_attached || attach_flight.valid()) {
+				// Evicted (or being attached): the next attach pins the latest version anyway
+				refresh_pending = false;
+				return;
+			}
+			base_name = internal_db_name + "@v" + std::to_string(++generation);
+		}
+		{
+			lock_guard<mutex> lock(snapshot_lock);
+			current_version = pinned_version;
+		}
+		auto latest_version = TryGetLatestVersion(context);
+		if (latest_version >= 0 && latest_version == current_version) {
+			// Nothing was committed since the attach, so the snapshot is current again
+			attached_at = SteadyClockMicros();
+			refresh_pending = false;
+			return;
+		}
+
+		string db_name;
+		auto version = AttachInternalDatabase(context, base_name, db_name);
+		auto &db_manager = DatabaseManager::Get(context);
+		auto attached = db_manager.GetDatabase(context, db_name);
+		if (!attached) {
+			throw InternalException("Internal delta database '%s' not found after attach", db_name);
+		}
+		auto new_db = attached->shared_from_this();
+		auto &new_table = LookupInternalTable(context, *new_db);
+		bool published = false;
+		{
+			lock_guard<mutex> lock(attach_lock);
+			if (is_attached && !attach_flight.valid()) {
+				replaced_db_names.push_back(current_db_name);
+				current_db_name = db_name;
+				internal_db = new_db;
+				lock_guard<mutex> snapshot_guard(snapshot_lock);
+				pinned_version = version;
+				snapshot.reset();
+				snapshot_failed = false;
+				cached_internal_table = &new_table;
+				published = true;
+			}
+		}
+		if (!published) {
+			// Evicted while the new version was attached
+			dc_catalog.snapshots.Release(context, db_name);
+			refresh_pending = false;
+			return;
+		}
+		// The new version may have a different schema
+		columns_synced = false;
+		attached_at = SteadyClockMicros();
+		refresh_pending = false;
+		PrefetchFooters(context);
+		dc_catalog.OnTableAttached(context, *this);
+	} catch (...) {
+		refresh_pending = false;
+		throw;
 	}
+}
 
-	auto &config = DBConfig::GetConfig(context);
-	AttachOptions options(opts, config.options.access_mode);
+bool DeltaClassicTableEntry::DetachReplaced(ClientContext &context) {
+	vector<string> db_names;
+	{
+		lock_guard<mutex> lock(attach_lock);
+		if (replaced_db_names.empty()) {
+			return true;
+		}
+		// A bind increments active_scans before it reads the cached table, so once the replacement is published
+		// a count of zero means no query can still be reading a replaced database
+		if (active_scans > 0) {
+			return false;
+		}
+		db_names = std::move(replaced_db_names);
+		replaced_db_names.clear();
+	}
+	auto &snapshots = catalog.Cast<DeltaClassicCatalog>().snapshots;
+	for (auto &name : db_names) {
+		snapshots.Release(context, name);
+	}
+	return true;
+}
+
+idx_t DeltaClassicTableEntry::GetLastUsed() const {
+	return last_used;
+}
+
+int64_t DeltaClassicTableEntry::AttachInternalDatabase(ClientContext &context, const string &base_name,
+                                                       string &db_name) {
+	auto &db_manager = DatabaseManager::Get(context);
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+
+	// With AS_OF_TIMESTAMP the version is fixed up front; scans read it through the delta extension's time travel
+	int64_t as_of_version = -1;
+	if (dc_catalog.options.as_of) {
+		DeltaClassicLogReader reader(DatabaseInstance::GetDatabase(context), FileSystem::GetFileSystem(context),
+		                             delta_table_path, dc_catalog.options.discovery_threads);
+		as_of_version = reader.GetVersionAtTimestamp(dc_catalog.options.as_of_timestamp_ms);
+	}
 
-	db_manager.AttachDatabase(context, info, options);
+	int64_t version_before = -1;
+	if (dc_catalog.options.pin_snapshot) {
+		dc_catalog.snapshots.ExpireHandOffs(context);
+		version_before = TryGetLatestVersion(context);
+		if (version_before >= 0) {
+			// Another catalog (e.g. a second ATTACH of the same path) may already hold this version
+			db_name = dc_catalog.snapshots.Acquire(delta_table_path, version_before);
+			if (!db_name.empty()) {
+				DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: shared '%s' at version %lld as '%s'",
+				                                            delta_table_path, version_before, db_name));
+				return version_before;
+			}
+		}
+	}
+
+	db_name = dc_catalog.snapshots.Reserve(base_name);
+	try {
+		// Check if already attached (e.g. by a user under the same name)
+		if (db_manager.GetDatabase(context, db_name)) {
+			return as_of_version;
+		}
+
+		// Use the programmatic attach API (not context.Query which deadlocks during binding)
+		AttachInfo info;
+		info.name = db_name;
+		info.path = delta_table_path;
+		info.on_conflict = OnCreateConflict::IGNORE_ON_CONFLICT;
+
+		unordered_map<string, Value> opts;
+		opts["type"] = Value("delta");
+		if (dc_catalog.options.pin_snapshot) {
+			opts["pin_snapshot"] = Value::BOOLEAN(true);
+		}
+
+		auto &config = DBConfig::GetConfig(context);
+		AttachOptions options(opts, config.options.access_mode);
+
+		db_manager.AttachDatabase(context, info, options);
+		DUCKDB_LOG_INFO(context,
+		                StringUtil::Format("delta_classic: attached '%s' as '%s'", delta_table_path, db_name));
 
-	dc_catalog.RegisterInternalDb(internal_db_name);
-	is_attached = true;
+		if (!dc_catalog.options.pin_snapshot) {
+			return as_of_version;
+		}
+		// The delta extension pins the latest version when it first loads the table, so load it now. If no commit
+		// landed meanwhile, the pinned version is the one listed before, and log statistics describe the scan
+		// exactly.
+		auto attached = db_manager.GetDatabase(context, db_name);
+		if (!attached) {
+			throw InternalException("Internal delta database '%s' not found after attach", db_name);
+		}
+		LookupInternalTable(context, *attached);
+		if (version_before >= 0 && TryGetLatestVersion(context) == version_before) {
+			// Only a database at a known version can be shared
+			dc_catalog.snapshots.Share(db_name, delta_table_path, version_before);
+			return version_before;
+		}
+		return -1;
+	} catch (...) {
+		dc_catalog.snapshots.Release(context, db_name);
+		throw;
+	}
 }
 
-TableCatalogEntry &DeltaClassicTableEntry::GetInternalTableEntry(ClientContext &context) {
+TableCatalogEntry &DeltaClassicTableEntry::GetInternalTableEntry(ClientContext &context, int64_t &scan_version) {
+	auto cached_table = cached_internal_table.load();
+	if (cached_table) {
+		return *cached_table;
+	}
 	EnsureAttached(context);
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (dc_catalog.options.pin_snapshot || dc_catalog.options.as_of) {
+		return FindInternalTableEntry(context);
+	}
+	if (dc_catalog.options.cache_small_tables == 0 && context.transaction.IsAutoCommit()) {
+		// A single statement needs no version of its own, so the scan opens the latest version itself and binds
+		// list no _delta_log. Only rewrites replacing the whole scan answer from the log (GetRewriteSnapshot).
+		return FindInternalTableEntry(context);
+	}
+	// Without pinning, the delta extension would open whatever version is latest when the scan binds. Scanning the
+	// version listed here instead lets the log-based answers of the transaction describe exactly the rows it reads.
+	scan_version = TryGetLatestVersion(context);
+	return FindInternalTableEntry(context, scan_version);
+}
 
-	// Look up the table in the internally attached delta database
-	auto &db_manager = DatabaseManager::Get(context);
-	auto db_entry = db_manager.GetDatabase(context, internal_db_name);
+TableCatalogEntry &DeltaClassicTableEntry::FindInternalTableEntry(ClientContext &context, int64_t at_version) {
+	shared_ptr<AttachedDatabase> db_entry;
+	string db_name;
+	{
+		lock_guard<mutex> lock(attach_lock);
+		db_entry = internal_db;
+		db_name = current_db_name;
+	}
 	if (!db_entry) {
-		throw InternalException("Internal delta database '%s' not found after attach", internal_db_name);
+		// Look up the internally attached delta database once; it stays attached while this catalog is
+		auto &db_manager = DatabaseManager::Get(context);
+		auto attached = db_manager.GetDatabase(context, db_name);
+		if (!attached) {
+			throw InternalException("Internal delta database '%s' not found after attach", db_name);
+		}
+		db_entry = attached->shared_from_this();
+		lock_guard<mutex> lock(attach_lock);
+		internal_db = db_entry;
+	}
+
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (dc_catalog.options.as_of) {
+		lock_guard<mutex> lock(snapshot_lock);
+		at_version = pinned_version;
 	}
+	auto &result = LookupInternalTable(context, *db_entry, at_version);
+	if (dc_catalog.options.pin_snapshot) {
+		// A pinned table keeps the same entry for the lifetime of the internal database, so later binds can
+		// skip the lookup. Without pinning, the delta extension creates a new entry (snapshot) per transaction.
+		cached_internal_table = &result;
+	}
+	return result;
+}
 
-	auto &internal_catalog = db_entry->GetCatalog();
+TableCatalogEntry &DeltaClassicTableEntry::LookupInternalTable(ClientContext &context, AttachedDatabase &db,
+                                                               int64_t at_version) {
+	auto &internal_catalog = db.GetCatalog();
 
 	// Delta attach puts the table in the default schema - scan to find it
 	auto &internal_schema = internal_catalog.GetSchema(context, DEFAULT_SCHEMA);
@@ -84,30 +590,247 @@ TableCatalogEntry &DeltaClassicTableEntry::GetInternalTableEntry(ClientContext &
 	});
 
 	if (!table_entry) {
-		throw InternalException("No table found in internally attached delta database '%s'", internal_db_name);
+		throw InternalException("No table found in internally attached delta database '%s'", db.GetName());
+	}
+	if (at_version < 0) {
+		return table_entry->Cast<TableCatalogEntry>();
 	}
 
-	return table_entry->Cast<TableCatalogEntry>();
+	// The same table read at an older version, i.e. AT (VERSION => at_version)
+	BoundAtClause at_clause("VERSION", Value::BIGINT(at_version));
+	EntryLookupInfo lookup(CatalogType::TABLE_ENTRY, table_entry->name, at_clause, QueryErrorContext());
+	auto versioned_entry = internal_schema.LookupEntry(CatalogTransaction(internal_catalog, context), lookup);
+	if (!versioned_entry) {
+		throw InternalException("Version %lld not found in internally attached delta database '%s'", at_version,
+		                        db.GetName());
+	}
+	return versioned_entry->Cast<TableCatalogEntry>();
 }
 
 TableFunction DeltaClassicTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
-	auto &internal_table = GetInternalTableEntry(context);
-	auto result = internal_table.GetScanFunction(context, bind_data);
+	stats.binds++;
+	auto replica_table = GetReplicaTable(context);
+	if (replica_table) {
+		// Served from local DuckDB storage, with its own statistics; neither the Delta log nor the data files are read
+		auto result = replica_table->GetScanFunction(context, bind_data);
+		// Late materialization would fetch the rows again through this entry
+		result.late_materialization = false;
+		return result;
+	}
+	// Keeps the internal database from being evicted until the query ends
+	DeltaClassicScanRegistry::Get(context).Use(*this);
+	// Every statement of a transaction scans the internal table its first statement did, so a transaction reads
+	// each table at one version even if a refresh (MAX_STALENESS) replaces it meanwhile
+	auto &transaction_table = DeltaClassicTransaction::Get(context, catalog).GetTable(*this);
+	if (!transaction_table.internal_table) {
+		transaction_table.internal_table = &GetInternalTableEntry(context, transaction_table.scan_version);
+	}
+	auto &internal_table = *transaction_table.internal_table;
+	TableFunction result;
+	auto small_table = GetMaterialized(context, internal_table);
+	if (small_table) {
+		bind_data = DeltaClassicCachedScan::Bind(std::move(small_table));
+		result = DeltaClassicCachedScan::GetFunction();
+		DeltaClassicScanRegistry::Get(context).Register(context, *bind_data, *this, internal_table);
+	} else {
+		result = internal_table.GetScanFunction(context, bind_data);
+		// Let the optimizer see cardinality and column statistics from the Delta log
+		auto &registry = DeltaClassicScanRegistry::Get(context);
+		registry.Register(context, *bind_data, *this, internal_table);
+		registry.WrapScanFunction(context, result, *this, internal_table);
+	}
+
+	if (!columns_synced.load(std::memory_order_acquire)) {
+		SyncColumns(internal_table.GetColumns());
+	}
+	ScheduleRefreshIfStale();
+	return result;
+}
 
-	// Update columns on this table entry so DESCRIBE works
-	auto &internal_columns = internal_table.GetColumns();
-	for (auto &col : internal_columns.Logical()) {
-		if (!ColumnExists(col.Name())) {
-			ColumnDefinition new_col(col.Name(), col.Type());
-			columns.AddColumn(std::move(new_col));
+optional_ptr<TableCatalogEntry> DeltaClassicTableEntry::GetReplicaTable(ClientContext &context) {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (!dc_catalog.replica) {
+		return nullptr;
+	}
+	auto replica_table = dc_catalog.replica->GetTable(context, schema.name, name);
+	if (!replica_table) {
+		return nullptr;
+	}
+	// Binds take the columns from this entry, so the copy is only used while it has the same ones. After a schema
+	// change the table is read from Delta until the next sync copies it again.
+	LoadColumns(DatabaseInstance::GetDatabase(context), FileSystem::GetFileSystem(context));
+	auto &replica_columns = replica_table->GetColumns();
+	lock_guard<mutex> lock(columns_lock);
+	if (columns.LogicalColumnCount() != replica_columns.LogicalColumnCount()) {
+		return nullptr;
+	}
+	for (idx_t i = 0; i < columns.LogicalColumnCount(); i++) {
+		auto &col = columns.GetColumn(LogicalIndex(i));
+		auto &replica_col = replica_columns.GetColumn(LogicalIndex(i));
+		if (col.Name() != replica_col.Name() || col.Type() != replica_col.Type()) {
+			return nullptr;
+		}
+	}
+	return replica_table;
+}
+
+shared_ptr<ColumnDataCollection> DeltaClassicTableEntry::GetMaterialized(ClientContext &context,
+                                                                          TableCatalogEntry &scanned_table) {
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	if (dc_catalog.options.cache_small_tables == 0) {
+		return nullptr;
+	}
+	// Only a table whose version is known exactly can be served from memory
+	auto current = GetScanSnapshot(context, scanned_table);
+	if (!current || current->GetTotalSize() > dc_catalog.options.cache_small_tables) {
+		return nullptr;
+	}
+	std::promise<shared_ptr<ColumnDataCollection>> read_promise;
+	std::shared_future<shared_ptr<ColumnDataCollection>> flight;
+	{
+		lock_guard<mutex> lock(materialized_lock);
+		if (materialized && materialized_version == current->version) {
+			materialized_last_used = dc_catalog.NextUseTick();
+			return materialized;
+		}
+		if (materialize_flight.valid() && materialize_flight_version == current->version) {
+			// Another bind is reading this version: wait for it instead of reading the table again
+			flight = materialize_flight;
+		} else {
+			materialize_flight = read_promise.get_future().share();
+			materialize_flight_version = current->version;
 		}
 	}
+	if (flight.valid()) {
+		return flight.get();
+	}
 
+	// Read the table on a connection of its own: running a query on the binding client would deadlock. A pinned
+	// internal database reads the pinned version; otherwise the version is given explicitly.
+	auto sql = "SELECT * FROM " + KeywordHelper::WriteOptionallyQuoted(scanned_table.ParentCatalog().GetName()) +
+	           "." + KeywordHelper::WriteOptionallyQuoted(scanned_table.schema.name) + "." +
+	           KeywordHelper::WriteOptionallyQuoted(scanned_table.name);
+	if (!dc_catalog.options.pin_snapshot) {
+		sql += " AT (VERSION => " + std::to_string(current->version) + ")";
+	}
+	shared_ptr<ColumnDataCollection> result;
+	try {
+		Connection con(DatabaseInstance::GetDatabase(context));
+		auto query_result = con.Query(sql);
+		// On an error the table is scanned through the delta extension as usual
+		if (!query_result->HasError() &&
+		    query_result->types.size() == scanned_table.GetColumns().LogicalColumnCount()) {
+			result = shared_ptr<ColumnDataCollection>(query_result->TakeCollection().release());
+		}
+	} catch (std::exception &) {
+		result = nullptr;
+	}
+	if (result) {
+		materialized_last_used = dc_catalog.NextUseTick();
+		dc_catalog.KeepMaterialized(*this, result, current->version);
+		DUCKDB_LOG_INFO(context, StringUtil::Format("delta_classic: cached '%s' at version %lld in memory",
+		                                            delta_table_path, current->version));
+	}
+	{
+		lock_guard<mutex> lock(materialized_lock);
+		if (materialize_flight_version == current->version) {
+			materialize_flight = std::shared_future<shared_ptr<ColumnDataCollection>>();
+		}
+	}
+	read_promise.set_value(result);
 	return result;
 }
 
+void DeltaClassicTableEntry::SetMaterialized(shared_ptr<ColumnDataCollection> collection, int64_t version) {
+	lock_guard<mutex> lock(materialized_lock);
+	materialized = std::move(collection);
+	materialized_version = materialized ? version : -1;
+}
+
+idx_t DeltaClassicTableEntry::GetMaterializedLastUsed() const {
+	return materialized_last_used;
+}
+
+void DeltaClassicTableEntry::SyncColumns(const ColumnList &internal_columns) {
+	// The delta extension is authoritative for the columns: replace the ones read from the log if they differ
+	lock_guard<mutex> lock(columns_lock);
+	bool columns_match = columns.LogicalColumnCount() == internal_columns.LogicalColumnCount();
+	for (idx_t i = 0; columns_match && i < columns.LogicalColumnCount(); i++) {
+		auto &col = columns.GetColumn(LogicalIndex(i));
+		auto &internal_col = internal_columns.GetColumn(LogicalIndex(i));
+		columns_match = col.Name() == internal_col.Name() && col.Type() == internal_col.Type();
+	}
+	if (!columns_match) {
+		ColumnList new_columns;
+		for (auto &col : internal_columns.Logical()) {
+			new_columns.AddColumn(ColumnDefinition(col.Name(), col.Type()));
+		}
+		columns = std::move(new_columns);
+	}
+	columns_loaded = true;
+	// A pinned snapshot's columns never change, so they only need to be compared once
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	columns_synced.store(dc_catalog.options.pin_snapshot, std::memory_order_release);
+}
+
+void DeltaClassicTableEntry::LoadColumns(DatabaseInstance &db, FileSystem &fs) {
+	lock_guard<mutex> lock(columns_lock);
+	if (columns_loaded) {
+		return;
+	}
+	columns_loaded = true;
+	try {
+		auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+		DeltaClassicLogReader reader(db, fs, delta_table_path, dc_catalog.options.discovery_threads);
+		auto metadata = reader.ReadMetadata();
+		ColumnList log_columns;
+		if (metadata->TryGetColumns(log_columns)) {
+			columns = std::move(log_columns);
+		}
+	} catch (std::exception &) {
+		// Not retried: the columns are filled in from the delta extension on the first scan
+	}
+}
+
+shared_ptr<DeltaClassicKeyIndex> DeltaClassicTableEntry::GetKeyIndex(ClientContext &context, const string &column) {
+	lock_guard<mutex> lock(key_index_lock);
+	auto entry = key_indexes.find(column);
+	if (entry != key_indexes.end()) {
+		return entry->second;
+	}
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	auto &fs = FileSystem::GetFileSystem(context);
+	shared_ptr<DeltaClassicKeyIndex> result;
+	if (columns.ColumnExists(column)) {
+		auto &definition = columns.GetColumn(column);
+		try {
+			auto path = DeltaClassicKeyIndex::GetPath(fs, dc_catalog.options.index_directory, delta_table_path,
+			                                          definition.Name());
+			result = shared_ptr<DeltaClassicKeyIndex>(
+			    DeltaClassicKeyIndex::Read(fs, path, definition.Name(), definition.Type()).release());
+		} catch (std::exception &) {
+			// Lookups scan the table as usual
+		}
+	}
+	key_indexes[column] = result;
+	return result;
+}
+
+void DeltaClassicTableEntry::SetKeyIndex(shared_ptr<DeltaClassicKeyIndex> index) {
+	lock_guard<mutex> lock(key_index_lock);
+	key_indexes[index->column] = std::move(index);
+}
+
 TableStorageInfo DeltaClassicTableEntry::GetStorageInfo(ClientContext &context) {
-	return TableStorageInfo();
+	TableStorageInfo result;
+	auto current = GetSnapshot(context);
+	if (current) {
+		auto row_count = current->GetRowCount();
+		if (row_count.IsValid()) {
+			result.cardinality = row_count.GetIndex();
+		}
+	}
+	return result;
 }
 
 } // namespace duckdb
@@ -0,0 +1,131 @@
+#include "storage/delta_classic_table_index.hpp"
+#include "storage/delta_classic_discovery.hpp"
+
+#include "duckdb/common/string_util.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+static int CompareNames(const char *a, idx_t a_length, const char *b, idx_t b_length) {
+	auto length = MinValue(a_length, b_length);
+	for (idx_t i = 0; i < length; i++) {
+		auto a_char = StringUtil::CharacterToLower(a[i]);
+		auto b_char = StringUtil::CharacterToLower(b[i]);
+		if (a_char != b_char) {
+			return a_char < b_char ? -1 : 1;
+		}
+	}
+	if (a_length == b_length) {
+		return 0;
+	}
+	return a_length < b_length ? -1 : 1;
+}
+
+DeltaClassicTableIndex::Entry DeltaClassicTableIndex::MakeEntry(const string &name, const string &path) {
+	// Tables of a schema share their directory, so only the last segment of the path is stored per table
+	auto split = path.find_last_of('/');
+	auto directory = split == string::npos ? string() : path.substr(0, split + 1);
+	auto entry = directory_ids.find(directory);
+	uint32_t directory_id;
+	if (entry == directory_ids.end()) {
+		directory_id = NumericCast<uint32_t>(directories.size());
+		directories.push_back(directory);
+		directory_ids.emplace(directory, directory_id);
+	} else {
+		directory_id = entry->second;
+	}
+
+	Entry result;
+	result.name_offset = NumericCast<uint32_t>(arena.size());
+	result.name_length = NumericCast<uint32_t>(name.size());
+	arena += name;
+	result.directory_id = directory_id;
+	result.segment_offset = NumericCast<uint32_t>(arena.size());
+	result.segment_length = NumericCast<uint32_t>(path.size() - directory.size());
+	arena.append(path, directory.size(), string::npos);
+	return result;
+}
+
+string DeltaClassicTableIndex::GetName(const Entry &entry) const {
+	return arena.substr(entry.name_offset, entry.name_length);
+}
+
+string DeltaClassicTableIndex::GetPath(const Entry &entry) const {
+	return directories[entry.directory_id] + arena.substr(entry.segment_offset, entry.segment_length);
+}
+
+int DeltaClassicTableIndex::CompareName(const Entry &entry, const char *name, idx_t name_length) const {
+	return CompareNames(arena.data() + entry.name_offset, entry.name_length, name, name_length);
+}
+
+idx_t DeltaClassicTableIndex::LowerBound(const string &name, bool &found) const {
+	auto position = std::lower_bound(entries.begin(), entries.end(), name, [&](const Entry &entry, const string &key) {
+		return CompareName(entry, key.data(), key.size()) < 0;
+	});
+	found = position != entries.end() && CompareName(*position, name.data(), name.size()) == 0;
+	return idx_t(position - entries.begin());
+}
+
+void DeltaClassicTableIndex::Assign(const vector<DeltaClassicDiscoveredTable> &tables) {
+	arena.clear();
+	directories.clear();
+	directory_ids.clear();
+	entries.clear();
+	entries.reserve(tables.size());
+	for (auto &table : tables) {
+		entries.push_back(MakeEntry(table.name, table.path));
+	}
+	// Sort once instead of inserting in order; equal names keep their listing order, so the last one wins
+	std::stable_sort(entries.begin(), entries.end(), [&](const Entry &a, const Entry &b) {
+		return CompareNames(arena.data() + a.name_offset, a.name_length, arena.data() + b.name_offset,
+		                    b.name_length) < 0;
+	});
+	idx_t count = 0;
+	for (idx_t i = 0; i < entries.size(); i++) {
+		if (count > 0 && CompareName(entries[count - 1], arena.data() + entries[i].name_offset,
+		                             entries[i].name_length) == 0) {
+			entries[count - 1] = entries[i];
+		} else {
+			entries[count++] = entries[i];
+		}
+	}
+	entries.resize(count);
+	entries.shrink_to_fit();
+}
+
+void DeltaClassicTableIndex::Add(const string &name, const string &path) {
+	bool found;
+	auto position = LowerBound(name, found);
+	auto entry = MakeEntry(name, path);
+	if (found) {
+		// The replaced strings stay in the arena until the next Assign
+		entries[position] = entry;
+	} else {
+		entries.insert(entries.begin() + NumericCast<int64_t>(position), entry);
+	}
+}
+
+bool DeltaClassicTableIndex::Find(const string &name, string &listed_name, string &path) const {
+	bool found;
+	auto position = LowerBound(name, found);
+	if (!found) {
+		return false;
+	}
+	listed_name = GetName(entries[position]);
+	path = GetPath(entries[position]);
+	return true;
+}
+
+idx_t DeltaClassicTableIndex::Count() const {
+	return entries.size();
+}
+
+void DeltaClassicTableIndex::ForEach(
+    const std::function<void(const string &name, const string &path)> &callback) const {
+	for (auto &entry : entries) {
+		callback(GetName(entry), GetPath(entry));
+	}
+}
+
+} // namespace duckdb
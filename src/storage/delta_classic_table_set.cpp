@@ -2,17 +2,22 @@
 #include "storage/delta_classic_catalog.hpp"
 #include "storage/delta_classic_schema_entry.hpp"
 #include "storage/delta_classic_table_entry.hpp"
+#include "storage/delta_classic_discovery.hpp"
+#include "storage/delta_classic_parallel.hpp"
 
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 
+#include <algorithm>
+
 namespace duckdb {
 
 DeltaClassicTableSet::DeltaClassicTableSet(DeltaClassicSchemaEntry &schema) : schema(schema), is_loaded(false) {
 }
 
-void DeltaClassicTableSet::LoadEntries(ClientContext &context) {
+void DeltaClassicTableSet::LoadEntries(FileSystem &fs) {
 	if (is_loaded) {
 		return;
 	}
@@ -22,47 +27,175 @@ void DeltaClassicTableSet::LoadEntries(ClientContext &context) {
 	}
 
 	auto &catalog = schema.ParentCatalog().Cast<DeltaClassicCatalog>();
-	auto &fs = FileSystem::GetFileSystem(context);
-
-	fs.ListFiles(schema.schema_path, [&](const string &filename, bool is_directory) {
-		if (!is_directory) {
-			return;
-		}
-		// Skip hidden and internal directories
-		if (filename.empty() || filename[0] == '.' || filename[0] == '_') {
-			return;
-		}
-		string subdir_path = schema.schema_path + "/" + filename;
-		string delta_log_path = subdir_path + "/_delta_log";
-
-		if (fs.DirectoryExists(delta_log_path)) {
-			CreateTableInfo info;
-			info.table = filename;
-			auto entry = make_uniq<DeltaClassicTableEntry>(catalog, schema, info, subdir_path);
-			tables[filename] = std::move(entry);
-		}
-	});
+	DeltaClassicTimer timer(schema.stats, schema.stats.list_tables);
+	DeltaClassicDiscovery discovery(fs, catalog.base_path, catalog.options, catalog.path_filter, schema.stats);
+	auto listed = discovery.ListTables(schema.schema_path);
+	index.Assign(listed);
+	for (auto &entry : tables) {
+		// Already resolved by a point lookup; keep the entry, it may be attached
+		index.Add(entry.first, entry.second->delta_table_path);
+	}
 
 	is_loaded = true;
 }
 
+DeltaClassicTableEntry &DeltaClassicTableSet::GetOrCreateEntry(const string &name, const string &path) {
+	auto &entry = tables[name];
+	if (!entry) {
+		auto &catalog = schema.ParentCatalog().Cast<DeltaClassicCatalog>();
+		CreateTableInfo info;
+		info.table = name;
+		entry = make_uniq<DeltaClassicTableEntry>(catalog, schema, info, path);
+	}
+	return *entry;
+}
+
+vector<reference<DeltaClassicTableEntry>> DeltaClassicTableSet::GetAllEntries() {
+	vector<reference<DeltaClassicTableEntry>> result;
+	result.reserve(index.Count());
+	index.ForEach([&](const string &name, const string &path) { result.push_back(GetOrCreateEntry(name, path)); });
+	return result;
+}
+
+optional_ptr<DeltaClassicTableEntry> DeltaClassicTableSet::ProbeEntry(FileSystem &fs, const string &name) {
+	auto &catalog = schema.ParentCatalog().Cast<DeltaClassicCatalog>();
+
+	DeltaClassicDiscoveredTable table;
+	{
+		DeltaClassicTimer timer(schema.stats, schema.stats.probe);
+		DeltaClassicDiscovery discovery(fs, catalog.base_path, catalog.options, catalog.path_filter, schema.stats);
+		if (!discovery.ProbeTable(schema.schema_path, name, table)) {
+			return nullptr;
+		}
+	}
+	lock_guard<mutex> lock(entry_lock);
+	string listed_name;
+	string listed_path;
+	if (!index.Find(table.name, listed_name, listed_path)) {
+		index.Add(table.name, table.path);
+		listed_name = table.name;
+		listed_path = table.path;
+	}
+	return &GetOrCreateEntry(listed_name, listed_path);
+}
+
 optional_ptr<CatalogEntry> DeltaClassicTableSet::GetEntry(ClientContext &context, const EntryLookupInfo &lookup) {
-	LoadEntries(context);
+	return GetEntry(FileSystem::GetFileSystem(context), lookup.GetEntryName()).get();
+}
+
+optional_ptr<DeltaClassicTableEntry> DeltaClassicTableSet::GetEntry(FileSystem &fs, const string &name) {
+	string listed_name;
+	string listed_path;
+	{
+		lock_guard<mutex> lock(entry_lock);
+		auto it = tables.find(name);
+		if (it != tables.end()) {
+			return *it->second;
+		}
+		if (index.Find(name, listed_name, listed_path)) {
+			return &GetOrCreateEntry(listed_name, listed_path);
+		}
+		if (is_loaded) {
+			return nullptr;
+		}
+	}
+	// Probe for just this table instead of listing the whole schema directory. A miss still falls back to
+	// the listing, as the name may differ in case from the directory on a case-sensitive file system.
+	auto probed = ProbeEntry(fs, name);
+	if (probed) {
+		return probed;
+	}
+	LoadEntries(fs);
 	lock_guard<mutex> lock(entry_lock);
-	auto &name = lookup.GetEntryName();
-	auto it = tables.find(name);
-	if (it == tables.end()) {
+	if (!index.Find(name, listed_name, listed_path)) {
 		return nullptr;
 	}
-	return it->second.get();
+	return &GetOrCreateEntry(listed_name, listed_path);
 }
 
 void DeltaClassicTableSet::Scan(ClientContext &context, const std::function<void(CatalogEntry &)> &callback) {
-	LoadEntries(context);
+	LoadEntries(FileSystem::GetFileSystem(context));
+	LoadColumns(context);
+	lock_guard<mutex> lock(entry_lock);
+	for (auto &entry : GetAllEntries()) {
+		callback(entry.get());
+	}
+}
+
+void DeltaClassicTableSet::ScanNames(ClientContext &context, const std::function<void(const string &)> &callback) {
+	LoadEntries(FileSystem::GetFileSystem(context));
+	lock_guard<mutex> lock(entry_lock);
+	index.ForEach([&](const string &name, const string &path) { callback(name); });
+}
+
+void DeltaClassicTableSet::LoadColumns(ClientContext &context) {
+	// Scans come from catalog browsing (duckdb_columns, information_schema), so read every table's schema from
+	// its log instead of attaching it. Reads run concurrently, as each one is a storage round trip.
+	auto entries = GetEntries(context);
+	auto &catalog = schema.ParentCatalog().Cast<DeltaClassicCatalog>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &fs = FileSystem::GetFileSystem(context);
+	DeltaClassicParallel::ForEach(entries.size(), catalog.options.discovery_threads,
+	                              [&](idx_t i) { entries[i].get().LoadColumns(db, fs); });
+}
+
+vector<reference<DeltaClassicTableEntry>> DeltaClassicTableSet::GetEntries(ClientContext &context) {
+	LoadEntries(FileSystem::GetFileSystem(context));
+	lock_guard<mutex> lock(entry_lock);
+	return GetAllEntries();
+}
+
+vector<reference<DeltaClassicTableEntry>> DeltaClassicTableSet::GetLoadedEntries() {
+	vector<reference<DeltaClassicTableEntry>> result;
 	lock_guard<mutex> lock(entry_lock);
 	for (auto &entry : tables) {
-		callback(*entry.second);
+		result.push_back(*entry.second);
 	}
+	std::sort(result.begin(), result.end(),
+	          [](const DeltaClassicTableEntry &a, const DeltaClassicTableEntry &b) { return a.name < b.name; });
+	return result;
+}
+
+void DeltaClassicTableSet::LoadListing(const vector<DeltaClassicDiscoveredTable> &listed) {
+	lock_guard<mutex> lock(entry_lock);
+	index.Assign(listed);
+	is_loaded = true;
+}
+
+bool DeltaClassicTableSet::NeedsRefresh() {
+	lock_guard<mutex> lock(entry_lock);
+	return is_loaded || index.Count() > 0;
+}
+
+void DeltaClassicTableSet::Refresh(const vector<DeltaClassicDiscoveredTable> &listed, DeltaClassicRefreshResult &result,
+                                   vector<unique_ptr<DeltaClassicTableEntry>> &retired) {
+	DeltaClassicTableIndex listed_index;
+	listed_index.Assign(listed);
+
+	lock_guard<mutex> lock(entry_lock);
+	// A table whose path changed counts as removed and added
+	string name;
+	string path;
+	index.ForEach([&](const string &indexed_name, const string &indexed_path) {
+		if (!listed_index.Find(indexed_name, name, path) || path != indexed_path) {
+			result.tables_removed++;
+		}
+	});
+	listed_index.ForEach([&](const string &listed_name, const string &listed_path) {
+		if (!index.Find(listed_name, name, path) || path != listed_path) {
+			result.tables_added++;
+		}
+	});
+	for (auto it = tables.begin(); it != tables.end();) {
+		if (listed_index.Find(it->first, name, path) && path == it->second->delta_table_path) {
+			it++;
+			continue;
+		}
+		retired.push_back(std::move(it->second));
+		it = tables.erase(it);
+	}
+	index = std::move(listed_index);
+	is_loaded = true;
 }
 
 void DeltaClassicTableSet::ScanNoContext(const std::function<void(CatalogEntry &)> &callback) {
@@ -70,8 +203,8 @@ void DeltaClassicTableSet::ScanNoContext(const std::function<void(CatalogEntry &
 	if (!is_loaded) {
 		return;
 	}
-	for (auto &entry : tables) {
-		callback(*entry.second);
+	for (auto &entry : GetAllEntries()) {
+		callback(entry.get());
 	}
 }
 
@@ -1,5 +1,6 @@
 #include "storage/delta_classic_transaction.hpp"
 #include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_table_entry.hpp"
 
 namespace duckdb {
 
@@ -8,10 +9,24 @@ DeltaClassicTransaction::DeltaClassicTransaction(DeltaClassicCatalog &catalog, T
     : Transaction(manager, context) {
 }
 
-DeltaClassicTransaction::~DeltaClassicTransaction() = default;
+DeltaClassicTransaction::~DeltaClassicTransaction() {
+	for (auto &entry : tables) {
+		entry.first.get().ReleaseScan();
+	}
+}
 
 DeltaClassicTransaction &DeltaClassicTransaction::Get(ClientContext &context, Catalog &catalog) {
 	return Transaction::Get(context, catalog).Cast<DeltaClassicTransaction>();
 }
 
+DeltaClassicTransactionTable &DeltaClassicTransaction::GetTable(DeltaClassicTableEntry &table) {
+	lock_guard<mutex> lock(tables_lock);
+	auto entry = tables.find(table);
+	if (entry != tables.end()) {
+		return entry->second;
+	}
+	table.AcquireScan();
+	return tables[table];
+}
+
 } // namespace duckdb
@@ -0,0 +1,173 @@
+#include "storage/delta_classic_union_entry.hpp"
+#include "storage/delta_classic_catalog.hpp"
+#include "storage/delta_classic_parallel.hpp"
+#include "storage/delta_classic_table_entry.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/exception/binder_exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/parsed_data/create_schema_info.hpp"
+#include "duckdb/parser/parsed_data/create_table_info.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+
+namespace duckdb {
+
+DeltaClassicUnionSchemaEntry::DeltaClassicUnionSchemaEntry(Catalog &catalog, CreateSchemaInfo &info)
+    : DeltaClassicSchemaEntry(catalog, info, string()) {
+}
+
+//! The columns of the tables of one name, matched by name across schemas: those of the first table (by schema name),
+//! then the ones only later tables have. A column whose type differs between tables takes a type they all cast to.
+static ColumnList GetUnionColumns(ClientContext &context, const vector<reference<DeltaClassicTableEntry>> &members) {
+	vector<string> names;
+	case_insensitive_map_t<LogicalType> types;
+	for (auto &member : members) {
+		for (auto &column : member.get().GetColumns().Logical()) {
+			auto entry = types.find(column.Name());
+			if (entry == types.end()) {
+				names.push_back(column.Name());
+				types.emplace(column.Name(), column.Type());
+				continue;
+			}
+			LogicalType max_type;
+			if (LogicalType::TryGetMaxLogicalType(context, entry->second, column.Type(), max_type)) {
+				entry->second = max_type;
+			}
+		}
+	}
+	ColumnList result;
+	for (auto &name : names) {
+		result.AddColumn(ColumnDefinition(name, types[name]));
+	}
+	return result;
+}
+
+static bool SameColumns(const ColumnList &a, const ColumnList &b) {
+	if (a.LogicalColumnCount() != b.LogicalColumnCount()) {
+		return false;
+	}
+	for (idx_t i = 0; i < a.LogicalColumnCount(); i++) {
+		auto &column_a = a.GetColumn(LogicalIndex(i));
+		auto &column_b = b.GetColumn(LogicalIndex(i));
+		if (column_a.Name() != column_b.Name() || column_a.Type() != column_b.Type()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+optional_ptr<CatalogEntry> DeltaClassicUnionSchemaEntry::LookupEntry(CatalogTransaction transaction,
+                                                                      const EntryLookupInfo &lookup_info) {
+	if (lookup_info.GetCatalogType() != CatalogType::TABLE_ENTRY) {
+		return nullptr;
+	}
+	if (!transaction.HasContext()) {
+		return nullptr;
+	}
+	auto &context = transaction.GetContext();
+	auto &dc_catalog = catalog.Cast<DeltaClassicCatalog>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	// Each schema not listed yet is probed for the table, a storage round trip, so they are looked up concurrently.
+	// The threads only use the file system, like discovery: the client context is not thread-safe.
+	auto schema_entries = dc_catalog.GetSchemas(context);
+	auto &name = lookup_info.GetEntryName();
+	vector<optional_ptr<DeltaClassicTableEntry>> found(schema_entries.size());
+	DeltaClassicParallel::ForEach(schema_entries.size(), dc_catalog.options.discovery_threads, [&](idx_t i) {
+		found[i] = schema_entries[i].get().tables.GetEntry(fs, name);
+		if (found[i]) {
+			found[i]->LoadColumns(db, fs);
+		}
+	});
+	vector<reference<DeltaClassicTableEntry>> members;
+	for (auto &entry : found) {
+		if (entry) {
+			members.push_back(*entry);
+		}
+	}
+	if (members.empty()) {
+		return nullptr;
+	}
+	// Built from the current members on every lookup, so columns of any schema's table and schema changes show up
+	auto columns = GetUnionColumns(context, members);
+	if (columns.LogicalColumnCount() == 0) {
+		throw BinderException("Could not read the columns of table \"%s\" from any Delta log", name);
+	}
+
+	lock_guard<mutex> lock(union_lock);
+	auto &union_table = union_tables[name];
+	if (!union_table || !SameColumns(union_table->GetColumns(), columns)) {
+		if (union_table) {
+			// Bound queries may still reference the entry with the previous columns
+			retired_tables.push_back(std::move(union_table));
+		}
+		CreateTableInfo info;
+		info.table = members[0].get().name;
+		info.columns = std::move(columns);
+		union_table = make_uniq<DeltaClassicUnionTableEntry>(catalog, *this, info);
+	}
+	union_table->SetMembers(std::move(members));
+	return union_table.get();
+}
+
+void DeltaClassicUnionSchemaEntry::Scan(ClientContext &context, CatalogType type,
+                                         const std::function<void(CatalogEntry &)> &callback) {
+	// Listing the union tables would repeat every table of the catalog
+}
+
+void DeltaClassicUnionSchemaEntry::Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) {
+}
+
+SimilarCatalogEntry DeltaClassicUnionSchemaEntry::GetSimilarEntry(CatalogTransaction transaction,
+                                                                  const EntryLookupInfo &lookup_info) {
+	// Not listed, like Scan
+	return SimilarCatalogEntry();
+}
+
+DeltaClassicUnionTableEntry::DeltaClassicUnionTableEntry(Catalog &catalog, SchemaCatalogEntry &schema,
+                                                         CreateTableInfo &info)
+    : TableCatalogEntry(catalog, schema, info) {
+}
+
+unique_ptr<BaseStatistics> DeltaClassicUnionTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
+	return nullptr;
+}
+
+static void DeltaClassicUnionScanFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	// The optimizer extension replaces this scan with the scans of the schemas' tables
+	throw InvalidInputException("Tables of the %s schema can only be queried with the optimizer enabled",
+	                            DELTA_CLASSIC_UNION_SCHEMA);
+}
+
+TableFunction DeltaClassicUnionTableEntry::GetScanFunction(ClientContext &context,
+                                                           unique_ptr<FunctionData> &bind_data) {
+	lock_guard<mutex> lock(members_lock);
+	bind_data = make_uniq<DeltaClassicUnionScanData>(members);
+	TableFunction result(DeltaClassicUnionScanData::FUNCTION_NAME, {}, DeltaClassicUnionScanFunction);
+	result.projection_pushdown = true;
+	return result;
+}
+
+TableStorageInfo DeltaClassicUnionTableEntry::GetStorageInfo(ClientContext &context) {
+	return TableStorageInfo();
+}
+
+virtual_column_map_t DeltaClassicUnionTableEntry::GetVirtualColumns() const {
+	auto result = TableCatalogEntry::GetVirtualColumns();
+	result.insert(make_pair(SCHEMA_NAME_COLUMN, TableColumn("schema_name", LogicalType::VARCHAR)));
+	return result;
+}
+
+void DeltaClassicUnionTableEntry::SetMembers(vector<reference<DeltaClassicTableEntry>> members_p) {
+	lock_guard<mutex> lock(members_lock);
+	members = std::move(members_p);
+}
+
+DeltaClassicUnionScanData::DeltaClassicUnionScanData(vector<reference<DeltaClassicTableEntry>> members)
+    : members(std::move(members)) {
+}
+
+} // namespace duckdb
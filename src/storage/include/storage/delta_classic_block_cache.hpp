@@ -0,0 +1,50 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/list.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+namespace duckdb {
+
+class FileSystem;
+
+//! Blocks of immutable data files kept on local disk (LOCAL_CACHE), one file per block, evicted least recently used
+//! first once they exceed the cache size. Delta never rewrites a data file in place, so a cached block stays valid
+//! for as long as it is kept. Blocks left in the directory by an earlier process are reused.
+class DeltaClassicBlockCache {
+public:
+	static constexpr idx_t BLOCK_SIZE = 1024 * 1024;
+
+	DeltaClassicBlockCache(const string &directory, idx_t max_size);
+
+	//! The cache of a directory, shared by every catalog of the process that uses it. The size given last applies.
+	static shared_ptr<DeltaClassicBlockCache> Get(const string &directory, idx_t max_size);
+	//! Identifies a data file's blocks
+	static string GetFileKey(const string &path, idx_t file_size);
+
+	bool Contains(const string &file_key, idx_t block);
+	//! Copies length bytes at offset within a cached block to buffer; returns false if the block is not cached
+	bool Read(const string &file_key, idx_t block, idx_t offset, data_ptr_t buffer, idx_t length);
+	//! Stores a block read from the data file. Failures are ignored: the block is read remotely again next time.
+	void Write(const string &file_key, idx_t block, const_data_ptr_t data, idx_t size);
+
+private:
+	string GetBlockName(const string &file_key, idx_t block) const;
+	//! Registers the blocks found in the directory and removes partially written ones
+	void LoadExisting();
+	//! Drops least recently used blocks until the cache fits, returning their names; lock must be held
+	vector<string> EvictBlocks();
+	void RemoveBlockFiles(const vector<string> &names);
+
+	string directory;
+	unique_ptr<FileSystem> fs;
+	mutex lock;
+	idx_t max_size;
+	idx_t total_size;
+	//! Cached blocks (name and size), most recently used first
+	list<pair<string, idx_t>> lru;
+	unordered_map<string, list<pair<string, idx_t>>::iterator> blocks;
+};
+
+} // namespace duckdb
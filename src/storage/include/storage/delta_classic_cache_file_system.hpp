@@ -0,0 +1,88 @@
+#pragma once
+
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "storage/delta_classic_stats.hpp"
+
+namespace duckdb {
+
+class DeltaClassicBlockCache;
+
+//! Serves reads of the Parquet data files under a catalog's base_path from a DeltaClassicBlockCache (LOCAL_CACHE)
+//! and from footers fetched ahead of the first scan (PREFETCH_FOOTERS). It is registered with the database's
+//! virtual file system while the catalog is attached and opens the files through whichever file system handles
+//! them otherwise (httpfs, azure, ...). The _delta_log is never cached.
+//! The virtual file system only holds a forwarding entry; the layer itself is shared by the catalog and every
+//! handle opened through it, so handles still open when the catalog is detached keep working.
+class DeltaClassicCacheFileSystem : public FileSystem, public enable_shared_from_this<DeltaClassicCacheFileSystem> {
+public:
+	//! Bytes of footers kept in memory; the oldest are dropped beyond it
+	static constexpr idx_t FOOTER_CACHE_SIZE = 256 * 1024 * 1024;
+
+	DeltaClassicCacheFileSystem(FileSystem &parent, string name, const string &base_path,
+	                            shared_ptr<DeltaClassicBlockCache> cache);
+
+	//! Registers a cache layer for the data files under base_path. cache may be null if only footers are cached.
+	static shared_ptr<DeltaClassicCacheFileSystem> Register(FileSystem &fs, const string &base_path,
+	                                                        shared_ptr<DeltaClassicBlockCache> cache);
+	//! Stops routing new opens through the layer. Open handles keep the layer alive until they are closed.
+	static void Unregister(FileSystem &fs, const string &name);
+
+	//! Bytes read through the layer (storage_read_bytes, cache_read_bytes), reported with the catalog's stats
+	DeltaClassicStats stats;
+
+	//! Reads the Parquet footers of the given data files on up to max_threads threads and keeps them in memory,
+	//! so scans opening the files do not fetch them one at a time. Files that cannot be read are skipped.
+	//! Returns the number of footers cached.
+	idx_t PrefetchFooters(const vector<string> &paths, idx_t max_threads);
+
+public:
+	string GetName() const override;
+	bool CanHandleFile(const string &fpath) override;
+	bool FileExists(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
+
+	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+	int64_t GetFileSize(FileHandle &handle) override;
+	timestamp_t GetLastModifiedTime(FileHandle &handle) override;
+	string GetVersionTag(FileHandle &handle) override;
+	void Seek(FileHandle &handle, idx_t location) override;
+	void Reset(FileHandle &handle) override;
+	idx_t SeekPosition(FileHandle &handle) override;
+	bool CanSeek() override;
+	bool OnDiskFile(FileHandle &handle) override;
+	//! Public so the entry registered with the virtual file system can forward opens
+	unique_ptr<FileHandle> OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
+	                                        optional_ptr<FileOpener> opener) override;
+	bool SupportsOpenFileExtended() const override;
+
+private:
+	//! The end of a data file, holding its footer
+	struct CachedFooter {
+		idx_t offset;
+		string data;
+	};
+
+	//! Identifies a data file by its path relative to base_path, however that is spelled, and its size
+	string GetFooterKey(const string &path, idx_t file_size) const;
+	bool PrefetchFooter(const string &path);
+	//! Copies a read from a cached footer; returns false if the range is not cached
+	bool ReadFooter(const string &footer_key, data_ptr_t buffer, idx_t length, idx_t location);
+
+	//! The virtual file system this is registered with
+	FileSystem &parent;
+	string name;
+	//! base_path with a trailing separator, and its absolute form for a relative local path
+	vector<string> prefixes;
+	shared_ptr<DeltaClassicBlockCache> cache;
+
+	mutex footers_lock;
+	unordered_map<string, CachedFooter> footers;
+	//! Footer keys in the order they were cached, for eviction
+	deque<string> footer_order;
+	idx_t footers_size;
+};
+
+} // namespace duckdb
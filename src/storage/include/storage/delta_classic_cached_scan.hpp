@@ -0,0 +1,18 @@
+#pragma once
+
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+//! Scans a table materialized in memory (CACHE_SMALL_TABLES) instead of the delegated delta scan. Filters are not
+//! pushed down: the table is small, so they are evaluated on the scanned rows.
+class DeltaClassicCachedScan {
+public:
+	static constexpr const char *FUNCTION_NAME = "delta_classic_cached_scan";
+
+	static TableFunction GetFunction();
+	static unique_ptr<FunctionData> Bind(shared_ptr<ColumnDataCollection> collection);
+};
+
+} // namespace duckdb
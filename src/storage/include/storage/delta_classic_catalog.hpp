@@ -1,22 +1,56 @@
 #pragma once
 
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/enums/access_mode.hpp"
 #include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/reference_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/vector.hpp"
+#include "storage/delta_classic_options.hpp"
+#include "storage/delta_classic_discovery.hpp"
+#include "storage/delta_classic_replica.hpp"
+#include "storage/delta_classic_stats.hpp"
+
+#include <condition_variable>
+#include <thread>
 
 namespace duckdb {
 
+class ColumnDataCollection;
+class DeltaClassicCacheFileSystem;
 class DeltaClassicSchemaEntry;
+class DeltaClassicSnapshotRegistry;
+class DeltaClassicTableEntry;
+class DeltaClassicUnionSchemaEntry;
+class FileSystem;
+
+//! What a catalog refresh changed
+struct DeltaClassicRefreshResult {
+	idx_t schemas_added = 0;
+	idx_t schemas_removed = 0;
+	idx_t tables_added = 0;
+	idx_t tables_removed = 0;
+};
 
 class DeltaClassicCatalog : public Catalog {
 public:
-	DeltaClassicCatalog(AttachedDatabase &db, const string &base_path, AccessMode access_mode, bool pin_snapshot);
+	DeltaClassicCatalog(AttachedDatabase &db, const string &base_path, AccessMode access_mode,
+	                    DeltaClassicOptions options, DeltaClassicSnapshotRegistry &snapshots);
 	~DeltaClassicCatalog() override;
 
 	string base_path;
 	AccessMode access_mode;
-	bool pin_snapshot;
+	DeltaClassicOptions options;
+	DeltaClassicPathFilter path_filter;
+	//! Internal delta databases of all delta_classic catalogs, shared across catalogs attaching the same path
+	DeltaClassicSnapshotRegistry &snapshots;
+	//! File system layer serving data files from LOCAL_CACHE and prefetched footers, if registered
+	shared_ptr<DeltaClassicCacheFileSystem> cache_file_system;
+	//! Local copy of the tables that scans read instead of Delta (REPLICA), if set
+	unique_ptr<DeltaClassicReplica> replica;
+	//! Discovery timings and storage requests (delta_classic_stats)
+	DeltaClassicStats stats;
 
 public:
 	void Initialize(bool load_builtin) override;
@@ -43,19 +77,92 @@ public:
 	string GetDBPath() override;
 
 	void OnDetach(ClientContext &context) override;
-	void RegisterInternalDb(const string &name);
+	//! Records a table whose internal delta database was just attached, and evicts the least recently used
+	//! tables if that exceeds MAX_ATTACHED_TABLES
+	void OnTableAttached(ClientContext &context, DeltaClassicTableEntry &table);
+	idx_t NextUseTick();
+	//! Makes a table read into memory the table's copy (CACHE_SMALL_TABLES), then drops the least recently used
+	//! copies, possibly this one, while all of them together exceed CACHE_SMALL_TABLES_SIZE
+	void KeepMaterialized(DeltaClassicTableEntry &table, shared_ptr<ColumnDataCollection> collection,
+	                      int64_t version);
+	//! Drops a table's copy in memory, if it has one
+	void DropMaterialized(DeltaClassicTableEntry &table);
+	//! Lists base_path again and diffs the result against the discovered schemas and tables, adding and
+	//! retiring entries in place. Tables that did not change keep their internal delta database attached.
+	//! With REPLICA, the replica is then brought up to date.
+	DeltaClassicRefreshResult Refresh(ClientContext &context);
+	//! Queues a table whose snapshot is older than MAX_STALENESS for a background RefreshSnapshot
+	void ScheduleSnapshotRefresh(DeltaClassicTableEntry &table);
+	//! The discovered schemas, ordered by name
+	vector<reference<DeltaClassicSchemaEntry>> GetSchemas(ClientContext &context);
+	//! The schemas discovered so far, ordered by name; never discovers
+	vector<reference<DeltaClassicSchemaEntry>> GetLoadedSchemas();
+	//! Attaches the tables' internal delta databases on up to DISCOVERY_THREADS threads, each on a connection of its
+	//! own. Errors are ignored; the table's next bind attaches it again and reports them.
+	void AttachTables(const vector<reference<DeltaClassicTableEntry>> &tables);
+	//! Copies new and changed tables into the REPLICA database and drops the copies of removed tables
+	DeltaClassicReplicaResult SyncReplica(ClientContext &context);
 
 private:
 	void DropSchema(ClientContext &context, DropInfo &info) override;
 	void DiscoverSchemas(ClientContext &context);
+	DeltaClassicRefreshResult RefreshListing(ClientContext &context);
+	//! Every discovered table; schemas not listed yet are listed on up to DISCOVERY_THREADS threads
+	vector<reference<DeltaClassicTableEntry>> ListAllTables(ClientContext &context);
+	//! Creates the schema and table entries of a discovered (or cached) listing
+	void ApplyListing(const DeltaClassicListing &listing);
+	DeltaClassicSchemaEntry &AddSchema(const string &schema_name, const string &schema_path);
+	//! Re-checks a listing read from the discovery cache in the background and rewrites the manifest if stale
+	void StartRevalidation(DeltaClassicListing listing);
+	//! Discovers all tables and attaches their internal delta databases on background threads (PREWARM)
+	void StartPrewarm();
+	//! Copies the tables into the REPLICA database on a background thread right after ATTACH
+	void StartReplicaSync();
+	//! Refreshes the catalog every REFRESH_INTERVAL on a background thread
+	void StartPeriodicRefresh();
+	//! Refreshes the snapshots queued by ScheduleSnapshotRefresh on a background thread (MAX_STALENESS)
+	void StartSnapshotRefresh();
+	//! Detaches the internal delta databases of retired tables that no running query uses
+	void DetachRetired(ClientContext &context, const vector<reference<DeltaClassicTableEntry>> &tables);
+	void StopBackgroundWork();
 
 private:
 	case_insensitive_map_t<unique_ptr<DeltaClassicSchemaEntry>> schemas;
 	bool schemas_loaded;
 	mutex schema_lock;
+	//! The __all__ schema, created on first lookup
+	unique_ptr<DeltaClassicUnionSchemaEntry> union_schema;
 
-	vector<string> internal_db_names;
+	//! Manifest file used when DISCOVERY_CACHE is set
+	string manifest_path;
+	std::thread revalidation_thread;
+	std::thread prewarm_thread;
+	std::thread refresh_thread;
+	std::thread snapshot_refresh_thread;
+	std::thread replica_thread;
+	//! Tells background work to stop starting new tasks
+	atomic<bool> stop_background_work;
+	//! Wakes background threads when work is queued or background work is stopped
+	mutex background_lock;
+	std::condition_variable background_cv;
+	//! Tables waiting for a snapshot refresh
+	vector<reference<DeltaClassicTableEntry>> stale_tables;
+	//! Serializes refreshes
+	mutex refresh_lock;
+	//! Schemas and tables removed by a refresh. Bound queries may still reference them, so they are kept alive
+	//! until the catalog is destroyed.
+	vector<unique_ptr<CatalogEntry>> retired_entries;
+
+	//! Tables whose internal delta database is currently attached
+	reference_set_t<DeltaClassicTableEntry> attached_tables;
 	mutex internal_db_lock;
+	atomic<idx_t> use_clock;
+
+	//! Tables holding a copy in memory (CACHE_SMALL_TABLES), with its size in bytes
+	reference_map_t<DeltaClassicTableEntry, idx_t> materialized_tables;
+	idx_t materialized_size = 0;
+	//! Serializes changes to the copies, so the sizes always describe what the tables hold
+	mutex materialized_lock;
 };
 
 } // namespace duckdb
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "storage/delta_classic_options.hpp"
+
+namespace duckdb {
+
+class DeltaClassicStats;
+class FileSystem;
+
+//! INCLUDE / EXCLUDE patterns matched against table paths relative to the attached directory
+//! (e.g. "CH0030/orders"). '*' and '?' match within a single path segment, '**' matches any number of segments.
+class DeltaClassicPathFilter {
+public:
+	DeltaClassicPathFilter(vector<string> include_patterns, vector<string> exclude_patterns);
+
+	//! Whether the table at the given relative path belongs in the catalog
+	bool Matches(const string &relative_path) const;
+	//! Whether the relative directory, or anything below it, may contain matching tables.
+	//! Used to avoid listing and probing directories that can never be queried.
+	bool MayContain(const string &relative_dir) const;
+
+	const vector<string> &IncludePatterns() const {
+		return include_patterns;
+	}
+
+private:
+	vector<string> include_patterns;
+	vector<string> exclude_patterns;
+};
+
+struct DeltaClassicDiscoveredTable {
+	string name;
+	string path;
+};
+
+struct DeltaClassicDiscoveredSchema {
+	string name;
+	string path;
+	//! Whether tables is complete; otherwise the schema directory is listed on first access
+	bool tables_loaded = false;
+	//! Fingerprint of the schema directory listing the tables were derived from
+	hash_t fingerprint = 0;
+	vector<DeltaClassicDiscoveredTable> tables;
+};
+
+//! The schema -> table -> path map of an attached directory
+struct DeltaClassicListing {
+	//! Fingerprint of the base directory listing (walk) or of all table paths (recursive)
+	hash_t fingerprint = 0;
+	vector<DeltaClassicDiscoveredSchema> schemas;
+};
+
+class DeltaClassicDiscovery {
+public:
+	//! Storage requests are counted in stats
+	DeltaClassicDiscovery(FileSystem &fs, const string &base_path, const DeltaClassicOptions &options,
+	                      const DeltaClassicPathFilter &filter, DeltaClassicStats &stats);
+
+	//! Discovers the schemas below base_path. In walk mode the tables of each schema directory are only
+	//! listed when load_tables is set; recursive discovery always finds every table.
+	DeltaClassicListing Discover(bool load_tables);
+	//! Lists the tables that are direct children of a schema directory
+	vector<DeltaClassicDiscoveredTable> ListTables(const string &schema_path);
+	//! Checks whether a single named table exists in a schema directory, without listing its siblings.
+	//! Applies the same rules as ListTables, so a probed table is always one the listing would also return.
+	bool ProbeTable(const string &schema_path, const string &table_name, DeltaClassicDiscoveredTable &result);
+	//! Re-checks a previously discovered listing against storage, updating it in place.
+	//! Directories whose listing fingerprint changed are listed again; in the others, only the child directories
+	//! that are not tables are probed, as they may have become tables. Returns true if anything changed.
+	bool Revalidate(DeltaClassicListing &listing);
+
+public:
+	//! Lists the visible child directories of path, in listing order.
+	//! Hidden entries (starting with '.') and the _delta_log directory itself are skipped.
+	static vector<string> ListChildDirectories(FileSystem &fs, const string &path, DeltaClassicStats &stats);
+	//! Checks which of the given directories are Delta tables (i.e. contain a _delta_log directory).
+	//! The checks run concurrently on up to max_threads threads; results are in the same order as dirs.
+	static vector<bool> ProbeDeltaTables(FileSystem &fs, const vector<string> &dirs, idx_t max_threads,
+	                                     DeltaClassicStats &stats);
+	//! Finds all Delta tables below base_path, at any depth, using one recursive glob per INCLUDE pattern
+	//! instead of a listing per directory. Returns the sorted table paths relative to base_path.
+	static vector<string> GlobDeltaTables(FileSystem &fs, const string &base_path, const DeltaClassicPathFilter &filter,
+	                                      DeltaClassicStats &stats);
+	//! Order-independent fingerprint of a set of names
+	static hash_t Fingerprint(const vector<string> &names);
+
+private:
+	DeltaClassicListing DiscoverByWalk(bool load_tables);
+	DeltaClassicListing DiscoverByGlob();
+	vector<DeltaClassicDiscoveredTable> ListTables(const string &schema_path, const vector<string> &child_dirs);
+	string RelativePath(const string &path) const;
+	//! Whether a child directory of a loaded schema that is not one of its tables now holds a _delta_log
+	bool HasNewTables(const DeltaClassicDiscoveredSchema &schema, const vector<string> &child_dirs);
+
+private:
+	FileSystem &fs;
+	const string &base_path;
+	const DeltaClassicOptions &options;
+	const DeltaClassicPathFilter &filter;
+	DeltaClassicStats &stats;
+};
+
+} // namespace duckdb
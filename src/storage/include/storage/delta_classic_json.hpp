@@ -0,0 +1,36 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+
+namespace duckdb {
+
+enum class DeltaClassicJsonType : uint8_t { JSON_NULL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+//! A parsed JSON value. Delta log actions are small documents, so a plain tree is all we need.
+struct DeltaClassicJsonValue {
+	DeltaClassicJsonType type = DeltaClassicJsonType::JSON_NULL;
+	//! Unescaped string contents, or the literal text of a number or boolean
+	string str;
+	//! Object member names, parallel to children
+	vector<string> keys;
+	//! Array elements or object member values
+	vector<unique_ptr<DeltaClassicJsonValue>> children;
+
+public:
+	//! Parses a JSON document; throws an IOException on malformed input
+	static unique_ptr<DeltaClassicJsonValue> Parse(const string &text);
+
+	bool IsNull() const {
+		return type == DeltaClassicJsonType::JSON_NULL;
+	}
+	//! Returns the member with the given name, or nullptr if this is not an object or has no such member
+	optional_ptr<const DeltaClassicJsonValue> Get(const string &key) const;
+	//! Returns the member as a string, or an empty string if it is missing or null
+	string GetString(const string &key) const;
+	//! Returns the member as an integer, or default_value if it is missing or not a number
+	int64_t GetInteger(const string &key, int64_t default_value) const;
+};
+
+} // namespace duckdb
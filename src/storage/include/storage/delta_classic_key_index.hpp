@@ -0,0 +1,61 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/types/value.hpp"
+
+namespace duckdb {
+
+class DatabaseInstance;
+class FileSystem;
+struct DeltaClassicSnapshot;
+
+//! A sidecar index of one column of a Delta table (delta_classic_build_index): for every data file, the exact
+//! min/max of the column and a bloom filter of its values. Equality lookups skip the files that cannot hold the key,
+//! which the per-file statistics in the Delta log are too coarse to rule out for high-cardinality keys.
+//! The index records the version it was built at; data files added later are not covered and always scanned.
+class DeltaClassicKeyIndex {
+public:
+	//! Bits per distinct value and bit positions per value; about 1% false positives
+	static constexpr idx_t BITS_PER_VALUE = 10;
+	static constexpr idx_t HASH_COUNT = 7;
+
+	struct FileEntry {
+		idx_t size = 0;
+		//! NULL if the file holds no non-NULL values
+		Value min;
+		Value max;
+		string bloom;
+	};
+
+	DeltaClassicKeyIndex(string column, LogicalType type);
+
+	string column;
+	LogicalType type;
+	//! Version of the table the index was built at
+	int64_t version = -1;
+	//! Data file path, as in the Delta log -> its entry
+	unordered_map<string, FileEntry> files;
+
+public:
+	//! Path of the index of a column: under index_directory if given, otherwise next to the table
+	static string GetPath(FileSystem &fs, const string &index_directory, const string &table_path,
+	                      const string &column);
+	//! Reads an index; returns nullptr if there is none or it was written for another column, type or format
+	static unique_ptr<DeltaClassicKeyIndex> Read(FileSystem &fs, const string &path, const string &column,
+	                                             const LogicalType &type);
+	//! Atomically replaces the index file
+	void Write(FileSystem &fs, const string &path) const;
+
+	//! Brings the index up to date with a snapshot: files still in it keep their entries, files no longer in it are
+	//! dropped and new ones are read on up to max_threads threads. Returns the number of files read.
+	idx_t Update(DatabaseInstance &db, const string &table_path, const DeltaClassicSnapshot &snapshot,
+	             idx_t max_threads);
+	//! Whether a data file may hold rows whose column equals value. Files not covered by the index may.
+	bool MayContain(const string &path, idx_t size, const Value &value) const;
+
+private:
+	FileEntry BuildEntry(DatabaseInstance &db, const string &file_path, idx_t size) const;
+};
+
+} // namespace duckdb
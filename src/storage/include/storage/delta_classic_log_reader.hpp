@@ -0,0 +1,138 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/parser/column_list.hpp"
+#include "storage/delta_classic_json.hpp"
+
+namespace duckdb {
+
+class BaseStatistics;
+class DatabaseInstance;
+class FileSystem;
+struct DeltaClassicFileChange;
+
+//! An active data file of a snapshot: an add action that has not been removed
+struct DeltaClassicDataFile {
+	//! Path relative to the table root (URL-decoded), or an absolute URI
+	string path;
+	idx_t size = 0;
+	//! Row count from the file statistics minus rows removed by a deletion vector; invalid if unknown
+	optional_idx num_records;
+	bool has_deletion_vector = false;
+	//! Partition column -> value as written in the log (NULL for null partitions)
+	unordered_map<string, Value> partition_values;
+	//! Parsed per-file statistics ({"numRecords", "minValues", "maxValues", "nullCount"}), if present
+	unique_ptr<DeltaClassicJsonValue> stats;
+};
+
+//! The state of a Delta table at one version, reconstructed from its _delta_log
+struct DeltaClassicSnapshot {
+	int64_t version = -1;
+	//! Schema of the table as a Delta JSON struct type
+	string schema_string;
+	vector<string> partition_columns;
+	//! Table properties (e.g. delta.columnMapping.mode)
+	unordered_map<string, string> configuration;
+	//! Active data files, sorted by path
+	vector<DeltaClassicDataFile> files;
+
+public:
+	//! Total number of rows, or invalid if some file has no statistics
+	optional_idx GetRowCount() const;
+	//! Total size in bytes of all data files
+	idx_t GetTotalSize() const;
+	//! Min/max/null information of a top-level column combined over all files.
+	//! Returns nullptr when the log does not hold usable statistics for the column.
+	unique_ptr<BaseStatistics> GetColumnStatistics(const string &column_name, const LogicalType &type) const;
+	//! Converts the schema string into columns with the types the delta extension gives them.
+	//! Returns false if the schema holds a type this reader does not know.
+	bool TryGetColumns(ColumnList &result) const;
+	//! Whether statistics and partition values are keyed by physical instead of logical column names
+	bool HasColumnMapping() const;
+	bool IsPartitionColumn(const string &column_name) const;
+	//! Partition value of a file cast to the column type (a NULL value for null partitions)
+	bool TryGetPartitionValue(const DeltaClassicDataFile &file, const string &column_name, const LogicalType &type,
+	                          Value &result) const;
+	//! Exact number of non-NULL values of a column (of rows, if the column name is empty) in the given files.
+	//! Returns false if the log does not hold enough information to know it.
+	bool TryGetExactCount(const vector<idx_t> &file_ids, const string &column_name, idx_t &result) const;
+	//! Exact minimum and maximum of a column in the given files (NULL if it only holds NULLs).
+	//! Returns false if the log does not hold enough information to know them.
+	bool TryGetExactMinMax(const vector<idx_t> &file_ids, const string &column_name, const LogicalType &type,
+	                       Value &min, Value &max) const;
+	//! Resolves a data file path from the log against the table root
+	static string GetAbsolutePath(const string &table_path, const string &file_path);
+	//! SQL reading the given data files with read_parquet as the given columns, with partition values from the log
+	//! and the version of each change as _commit_version. Columns none of the files hold are NULL. Deletion vectors
+	//! are not applied.
+	string GetFilesQuery(const string &table_path, const ColumnList &columns,
+	                     const vector<DeltaClassicFileChange> &files) const;
+};
+
+//! A data file added or removed by a commit
+struct DeltaClassicFileChange {
+	int64_t version;
+	DeltaClassicDataFile file;
+};
+
+//! The data files the commits in a range of versions added and removed, in commit order
+struct DeltaClassicChanges {
+	vector<DeltaClassicFileChange> added;
+	vector<DeltaClassicFileChange> removed;
+};
+
+//! Reads snapshots directly from a table's _delta_log: the newest checkpoint plus the JSON commits after it.
+//! This is a small metadata reader for catalog purposes; scans are still served by the delta extension.
+class DeltaClassicLogReader {
+public:
+	DeltaClassicLogReader(DatabaseInstance &db, FileSystem &fs, const string &table_path, idx_t max_threads);
+
+	//! Lists _delta_log and returns the latest committed version, or -1 if the table has no commits
+	int64_t GetLatestVersion();
+	//! Returns the latest version committed at or before the given time (milliseconds since the epoch), using the
+	//! commit timestamps in the commitInfo actions, each taken as no earlier than those of the commits before it.
+	//! Throws if every retained commit is newer.
+	int64_t GetVersionAtTimestamp(int64_t timestamp_ms);
+	//! Replays the log up to the given version (the latest if negative) into a snapshot
+	shared_ptr<DeltaClassicSnapshot> ReadSnapshot(int64_t version = -1);
+	//! Reads only the latest metadata (schema, partition columns, properties) into a snapshot without files.
+	//! Commits are read newest first, max_threads at a time, until one changes the metadata; the checkpoint is only
+	//! read if none did.
+	shared_ptr<DeltaClassicSnapshot> ReadMetadata();
+	//! Reads the files added and removed by the commits from_version through to_version. Actions that do not change
+	//! the table's rows (dataChange false, e.g. compaction) are skipped. Throws if a commit is no longer in the log.
+	DeltaClassicChanges ReadChanges(int64_t from_version, int64_t to_version);
+
+private:
+	struct LogListing {
+		//! Versions with a JSON commit file, sorted
+		vector<int64_t> commits;
+		//! Checkpoint version -> its parquet part files (complete multi-part checkpoints only)
+		map<int64_t, vector<string>> checkpoints;
+	};
+
+	LogListing ListLog();
+	string ReadFile(const string &path);
+	//! Commit timestamp of a version (inCommitTimestamp if enabled), or -1 if the commit records none
+	int64_t ReadCommitTimestamp(int64_t version);
+	//! Reads the add and metaData actions of a checkpoint; only the metaData action if active_files is not given
+	void ReadCheckpoint(const vector<string> &part_files, DeltaClassicSnapshot &snapshot,
+	                    optional_ptr<unordered_map<string, DeltaClassicDataFile>> active_files);
+	void ApplyCommit(const string &contents, DeltaClassicSnapshot &snapshot,
+	                 unordered_map<string, DeltaClassicDataFile> &active_files);
+	static string CommitFileName(int64_t version);
+
+private:
+	DatabaseInstance &db;
+	FileSystem &fs;
+	string table_path;
+	string log_path;
+	idx_t max_threads;
+};
+
+} // namespace duckdb
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "storage/delta_classic_discovery.hpp"
+#include "storage/delta_classic_options.hpp"
+
+namespace duckdb {
+
+class FileSystem;
+
+//! On-disk copy of a catalog's discovery listing (DISCOVERY_CACHE), so warm attaches skip the directory walk.
+//! The listing fingerprints are stored alongside it and used to revalidate the manifest cheaply.
+class DeltaClassicManifest {
+public:
+	//! Path of the manifest for the given attach: one file per base path and discovery settings
+	static string GetPath(FileSystem &fs, const string &cache_dir, const string &base_path,
+	                      const DeltaClassicOptions &options);
+
+	//! Reads a manifest; returns false if there is none or it was written for another base path or format. Throws
+	//! if the file cannot be read or a field cannot be parsed.
+	static bool Read(FileSystem &fs, const string &manifest_path, const string &base_path,
+	                 DeltaClassicListing &listing);
+	//! Atomically replaces the manifest with the given listing
+	static void Write(FileSystem &fs, const string &manifest_path, const string &base_path,
+	                  const DeltaClassicListing &listing);
+};
+
+} // namespace duckdb
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+
+enum class DeltaClassicDiscoveryMode : uint8_t {
+	//! List base_path, then every schema directory, probing each child for a _delta_log
+	WALK,
+	//! Find every _delta_log at any depth with one recursive glob listing
+	RECURSIVE
+};
+
+//! Options given to ATTACH ... (TYPE delta_classic, ...)
+struct DeltaClassicOptions {
+	//! Pin each table's snapshot at first attach (PIN_SNAPSHOT)
+	bool pin_snapshot = false;
+	//! Read every table at its latest version committed at or before as_of_timestamp_ms (AS_OF_TIMESTAMP)
+	bool as_of = false;
+	//! Milliseconds since the epoch (UTC), compared against the commit timestamps in the Delta logs
+	int64_t as_of_timestamp_ms = 0;
+	//! Maximum number of concurrent storage requests issued during discovery (DISCOVERY_THREADS)
+	idx_t discovery_threads = 16;
+	//! How tables are discovered (DISCOVERY_MODE)
+	DeltaClassicDiscoveryMode discovery_mode = DeltaClassicDiscoveryMode::WALK;
+	//! Only tables whose relative path matches one of these patterns are discovered (INCLUDE)
+	vector<string> include_patterns;
+	//! Tables whose relative path matches one of these patterns are skipped (EXCLUDE)
+	vector<string> exclude_patterns;
+	//! Discover tables and attach them in the background right after ATTACH (PREWARM)
+	bool prewarm = false;
+	//! Maximum number of internal delta databases kept attached; 0 means no limit (MAX_ATTACHED_TABLES)
+	idx_t max_attached_tables = 0;
+	//! Local directory holding discovery manifests for warm attaches; empty disables the cache (DISCOVERY_CACHE)
+	string discovery_cache;
+	//! Age, in microseconds, after which a pinned snapshot is replaced by the latest version in the background;
+	//! 0 keeps pinned snapshots forever (MAX_STALENESS, implies pin_snapshot)
+	int64_t max_staleness = 0;
+	//! Interval, in microseconds, at which the catalog is refreshed in the background; 0 disables (REFRESH_INTERVAL)
+	int64_t refresh_interval = 0;
+	//! Local directory caching blocks of the tables' data files; empty disables the cache (LOCAL_CACHE)
+	string local_cache;
+	//! Maximum bytes kept in the LOCAL_CACHE directory (LOCAL_CACHE_SIZE)
+	idx_t local_cache_size = 10ULL * 1024 * 1024 * 1024;
+	//! Read the Parquet footers of a table's data files in parallel when it is attached (PREFETCH_FOOTERS)
+	bool prefetch_footers = false;
+	//! Tables whose data files total fewer bytes are read into memory once per version and scanned from there;
+	//! 0 disables (CACHE_SMALL_TABLES)
+	idx_t cache_small_tables = 0;
+	//! Maximum bytes of memory the tables kept by CACHE_SMALL_TABLES take together (CACHE_SMALL_TABLES_SIZE)
+	idx_t cache_small_tables_size = 1ULL * 1024 * 1024 * 1024;
+	//! Directory holding the key indexes built by delta_classic_build_index; empty stores them next to each table
+	//! (INDEX_DIRECTORY)
+	string index_directory;
+	//! Local DuckDB database file holding a copy of every table, which scans read instead; empty disables (REPLICA)
+	string replica;
+	//! Time, in microseconds, a detached catalog's pinned snapshots stay attached for the next catalog attaching the
+	//! same tables to take over; 0 detaches them with the catalog (HANDOFF, implies pin_snapshot)
+	int64_t handoff = 0;
+};
+
+} // namespace duckdb
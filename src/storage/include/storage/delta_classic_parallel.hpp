@@ -0,0 +1,16 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+class DeltaClassicParallel {
+public:
+	//! Runs task(i) for every i in [0, count) on at most max_threads worker threads.
+	//! If any task throws, no new tasks are started and the first error is rethrown on the calling thread.
+	static void ForEach(idx_t count, idx_t max_threads, const std::function<void(idx_t)> &task);
+};
+
+} // namespace duckdb
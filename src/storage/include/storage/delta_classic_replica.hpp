@@ -0,0 +1,78 @@
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+class DatabaseInstance;
+class DeltaClassicTableEntry;
+class TableCatalogEntry;
+
+//! What a replica sync changed
+struct DeltaClassicReplicaResult {
+	idx_t tables_copied = 0;
+	idx_t tables_appended = 0;
+	idx_t tables_dropped = 0;
+	//! Tables whose copy could not be brought up to date; the previous copy, if any, is still served
+	idx_t tables_failed = 0;
+};
+
+//! A local DuckDB database holding a copy of every table of a catalog (REPLICA). Each table is copied to
+//! <schema>.<table>, and the Delta version it was copied from is recorded in __delta_classic.tables in the same
+//! transaction. A sync skips tables whose version did not change, appends the added files when the new commits only
+//! added files, and copies the table again otherwise. Scans of tables with a copy read the copy.
+class DeltaClassicReplica {
+public:
+	DeltaClassicReplica(string path, string db_name);
+
+	//! Path of the replica database file
+	string path;
+	//! Name the replica database is attached under
+	string db_name;
+
+public:
+	//! The copy of a table, or nullptr if it has none (yet). Attaches the replica on first use.
+	optional_ptr<TableCatalogEntry> GetTable(ClientContext &context, const string &schema_name,
+	                                         const string &table_name);
+	//! Brings the copies of the given tables up to date, up to max_threads at a time, and drops the copies of other
+	//! tables. Tables that fail to copy keep their previous copy. Stops starting copies once stop is set.
+	DeltaClassicReplicaResult Sync(ClientContext &context, const vector<reference<DeltaClassicTableEntry>> &tables,
+	                               idx_t max_threads, const atomic<bool> &stop);
+	//! Detaches the replica database, if it was attached
+	void Detach(ClientContext &context);
+
+private:
+	enum class SyncOutcome : uint8_t { UNCHANGED, COPIED, APPENDED };
+
+	struct CopiedTable {
+		string schema_name;
+		string table_name;
+		string table_path;
+		//! Version the copy holds, or -1 if unknown (the next sync copies the table again)
+		int64_t version = -1;
+		//! The copied columns as "name TYPE" pairs, empty if not read from the log; appending requires a match
+		string columns;
+	};
+
+	//! Attaches the replica database with the programmatic API (safe during binding) and reads its table versions
+	void EnsureAttached(ClientContext &context);
+	SyncOutcome SyncTable(DatabaseInstance &db, DeltaClassicTableEntry &table, idx_t max_threads);
+	//! Drops the copy of a table and its version in one transaction
+	void DropTable(DatabaseInstance &db, const CopiedTable &table);
+	//! Fully qualified name of a table in the replica database
+	string GetTableName(const string &schema_name, const string &table_name) const;
+
+	mutex attach_lock;
+	bool attached;
+	//! Serializes syncs
+	mutex sync_lock;
+	mutex tables_lock;
+	//! Qualified table name -> its copy
+	case_insensitive_map_t<CopiedTable> tables;
+};
+
+} // namespace duckdb
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/reference_map.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context_state.hpp"
+
+namespace duckdb {
+
+class DeltaClassicTableEntry;
+class TableCatalogEntry;
+struct DeltaClassicSnapshot;
+
+//! A delta_classic scan bound in the current query
+struct DeltaClassicBoundScan {
+	optional_ptr<DeltaClassicTableEntry> table;
+	//! The internal delta table the scan was bound against
+	optional_ptr<TableCatalogEntry> internal_table;
+	//! The snapshot the scan reads, or nullptr if it is not known
+	shared_ptr<DeltaClassicSnapshot> snapshot;
+	//! Callbacks of the delegated delta scan, set even if the bind data was not registered
+	table_function_cardinality_t delegate_cardinality = nullptr;
+	table_statistics_t delegate_statistics = nullptr;
+};
+
+//! Remembers which delta_classic table each scan bound in the current query belongs to.
+//! The bind data of the delegated delta scan is opaque to this extension, so the wrapped scan callbacks use the
+//! registry to find their way back to the DeltaClassicTableEntry. The registry belongs to one client, and it is
+//! cleared when the query ends, so a bind data address is never confused with one from another client or an
+//! earlier query.
+class DeltaClassicScanRegistry : public ClientContextState {
+public:
+	~DeltaClassicScanRegistry() override;
+
+	static DeltaClassicScanRegistry &Get(ClientContext &context);
+	//! Returns the scan a bind data was registered for; table is nullptr if there is none
+	static DeltaClassicBoundScan Lookup(ClientContext &context, const FunctionData *bind_data);
+
+	//! Marks the table as in use until the query ends, so its internal database is not evicted meanwhile
+	void Use(DeltaClassicTableEntry &table);
+	void Register(ClientContext &context, const FunctionData &bind_data, DeltaClassicTableEntry &table,
+	              TableCatalogEntry &internal_table);
+	//! Replaces the cardinality and statistics callbacks of a delegated scan with ones that consult the Delta log
+	//! of the registered table and fall back to the original callbacks otherwise. to_string is extended with the
+	//! snapshot the scan reads, for EXPLAIN and the profiler.
+	void WrapScanFunction(ClientContext &context, TableFunction &function, DeltaClassicTableEntry &table,
+	                      TableCatalogEntry &internal_table);
+	void QueryEnd() override;
+
+private:
+	//! Drops the scan descriptions of described_functions whose plans are gone; lock must be held
+	void RemoveExpiredDescriptions();
+
+private:
+	mutex lock;
+	unordered_map<const FunctionData *, DeltaClassicBoundScan> scans;
+	vector<reference<DeltaClassicTableEntry>> used_tables;
+	//! Callbacks of the delegated delta scan, for bind data the planner copied, which are not registered
+	table_function_cardinality_t delegate_cardinality = nullptr;
+	table_statistics_t delegate_statistics = nullptr;
+	//! Scan functions this client described for EXPLAIN, whose descriptions are removed once their plans are gone
+	vector<weak_ptr<TableFunctionInfo>> described_functions;
+};
+
+} // namespace duckdb
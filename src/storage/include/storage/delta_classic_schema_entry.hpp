@@ -1,6 +1,7 @@
 #pragma once
 
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "storage/delta_classic_stats.hpp"
 #include "storage/delta_classic_table_set.hpp"
 
 namespace duckdb {
@@ -34,11 +35,15 @@ public:
 	void Scan(ClientContext &context, CatalogType type,
 	          const std::function<void(CatalogEntry &)> &callback) override;
 	void Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+	//! Compares the names of the tables only, so suggesting a table does not read every table's log like Scan does
+	SimilarCatalogEntry GetSimilarEntry(CatalogTransaction transaction, const EntryLookupInfo &lookup_info) override;
 	void DropEntry(ClientContext &context, DropInfo &info) override;
 	void Alter(CatalogTransaction transaction, AlterInfo &info) override;
 
 public:
 	DeltaClassicTableSet tables;
+	//! Timings and storage requests of listing the schema directory and probing for tables (delta_classic_stats)
+	DeltaClassicStats stats;
 };
 
 } // namespace duckdb
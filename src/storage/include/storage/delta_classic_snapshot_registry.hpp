@@ -0,0 +1,84 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/storage_extension.hpp"
+
+#include <condition_variable>
+#include <thread>
+
+namespace duckdb {
+
+class ClientContext;
+class DatabaseInstance;
+
+//! The internal delta databases of every delta_classic catalog of a database instance, reference counted by the
+//! tables that read them. A database pinned at a known version is shared: a catalog that attaches the same table
+//! path at the same version reads it instead of attaching its own copy of the snapshot. A detaching catalog can hand
+//! its shared databases off to the registry (HANDOFF), so a catalog attaching the same tables next takes them over.
+class DeltaClassicSnapshotRegistry : public StorageExtensionInfo {
+public:
+	DeltaClassicSnapshotRegistry();
+	~DeltaClassicSnapshotRegistry() override;
+
+	//! Returns an internal database name no other table uses, base_name if possible, and takes the first
+	//! reference to it. The caller then attaches the database under that name.
+	string Reserve(const string &base_name);
+	//! Offers a reserved database, pinned at version of table_path, to later Acquire calls
+	void Share(const string &db_name, const string &table_path, int64_t version);
+	//! Takes a reference to the shared database of table_path at version, or takes over a handed off one. Returns
+	//! its name, or an empty string if none is attached.
+	string Acquire(const string &table_path, int64_t version);
+	//! Drops a reference; the internal database is detached with the last one
+	void Release(ClientContext &context, const string &db_name);
+	//! Drops a reference like Release, except that a shared database is kept attached for timeout microseconds for
+	//! an Acquire to take over. Returns whether it was kept. A background thread releases it once the timeout
+	//! passes, even if no delta_classic catalog is used again.
+	bool HandOff(ClientContext &context, const string &db_name, int64_t timeout);
+	//! Releases the handed off databases nobody took over in time
+	void ExpireHandOffs(ClientContext &context);
+
+private:
+	//! What the expiry thread shares with the registry. The thread keeps it alive, as it may drop the last
+	//! reference to the database instance, and with it the registry, before it checks stop.
+	struct ExpiryState {
+		mutex lock;
+		std::condition_variable cv;
+		bool stop = false;
+		//! Set when a hand off may have moved the next deadline
+		bool wake = false;
+		weak_ptr<DatabaseInstance> db;
+	};
+
+	struct RegisteredDatabase {
+		idx_t references = 0;
+		//! Key in shared_databases, or empty if the database is not shared
+		string shared_key;
+		//! Whether one of the references is held for a catalog taking the database over, and until when (in
+		//! microseconds of the steady clock)
+		bool handed_off = false;
+		int64_t handoff_expires_at = 0;
+		//! Set while the database is detached; the name stays taken until then
+		bool detaching = false;
+	};
+
+	static string GetSharedKey(const string &table_path, int64_t version);
+
+	mutex lock;
+	//! Registered databases by name
+	unordered_map<string, RegisteredDatabase> databases;
+	//! Names of the shared databases, by table path and version
+	unordered_map<string, string> shared_databases;
+
+	//! Starts the expiry thread, or wakes it up if it is running
+	void StartExpiry(DatabaseInstance &db);
+	//! Earliest deadline of the handed off databases, or -1 if there are none
+	int64_t NextHandOffDeadline();
+	void RunExpiry(shared_ptr<ExpiryState> state);
+
+	shared_ptr<ExpiryState> expiry;
+	std::thread expiry_thread;
+};
+
+} // namespace duckdb
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+
+namespace duckdb {
+
+//! A distribution of recorded values (latencies in microseconds, sizes in bytes). Values are counted in
+//! power-of-two buckets, so percentiles are upper bounds within a factor of two.
+struct DeltaClassicHistogram {
+	static constexpr idx_t BUCKET_COUNT = 65;
+
+	idx_t count = 0;
+	idx_t total = 0;
+	idx_t min = 0;
+	idx_t max = 0;
+	//! Bucket i holds the values of bit width i, i.e. 0 or [2^(i-1), 2^i)
+	idx_t buckets[BUCKET_COUNT] = {};
+
+	void Record(idx_t value);
+	//! Upper bound of the values at or below the given quantile (0 to 1)
+	idx_t Quantile(double quantile) const;
+};
+
+//! One row of delta_classic_stats(): a counter, or a histogram with its distribution
+struct DeltaClassicMetric {
+	string name;
+	//! "us", "bytes" or "calls"
+	string unit;
+	idx_t count = 0;
+	bool is_histogram = false;
+	idx_t total = 0;
+	idx_t min = 0;
+	idx_t max = 0;
+	idx_t p50 = 0;
+	idx_t p99 = 0;
+};
+
+//! Timings and counters of a catalog, schema or table, exposed by delta_classic_stats() and gathered for as long
+//! as the catalog is attached. Each object only fills in the metrics of its own work.
+class DeltaClassicStats {
+public:
+	//! Discovery of the schemas and tables below base_path (catalog), in microseconds
+	DeltaClassicHistogram discovery;
+	//! Listings of a schema directory (schema), in microseconds
+	DeltaClassicHistogram list_tables;
+	//! Point lookups of a table by its _delta_log (schema), in microseconds
+	DeltaClassicHistogram probe;
+	//! Attaches of the internal delta database (table), in microseconds
+	DeltaClassicHistogram attach;
+	//! Bytes of all data files in the table version each scan was bound to, whether or not the scan reads them
+	//! (table). Pruned, cached and indexed scans read less; storage_read_bytes counts what is fetched.
+	DeltaClassicHistogram scanned_table_bytes;
+	//! Storage requests made by discovery: directory listings (and globs), and _delta_log existence checks
+	atomic<idx_t> list_calls {0};
+	atomic<idx_t> exists_calls {0};
+	//! Scans bound against the table
+	atomic<idx_t> binds {0};
+	//! Bytes of data files read through the cache layer (LOCAL_CACHE, PREFETCH_FOOTERS): fetched from storage, and
+	//! served from the block cache or from prefetched footers (cache layer, reported with its catalog)
+	atomic<idx_t> storage_read_bytes {0};
+	atomic<idx_t> cache_read_bytes {0};
+
+public:
+	void Record(DeltaClassicHistogram &histogram, idx_t value);
+	//! The metrics recorded so far; metrics that were never recorded are left out
+	vector<DeltaClassicMetric> GetMetrics();
+	//! Microseconds of the steady clock, for timing
+	static int64_t Now();
+
+private:
+	//! Guards the histograms
+	mutex lock;
+};
+
+//! Records the microseconds from construction to destruction in a histogram of stats
+class DeltaClassicTimer {
+public:
+	DeltaClassicTimer(DeltaClassicStats &stats, DeltaClassicHistogram &histogram);
+	~DeltaClassicTimer();
+
+private:
+	DeltaClassicStats &stats;
+	DeltaClassicHistogram &histogram;
+	int64_t start;
+};
+
+} // namespace duckdb
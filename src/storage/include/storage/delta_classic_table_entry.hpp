@@ -3,10 +3,23 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
 #include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "storage/delta_classic_stats.hpp"
+
+#include <future>
 
 namespace duckdb {
 
+class AttachedDatabase;
+class ColumnDataCollection;
+class DatabaseInstance;
 class DeltaClassicCatalog;
+class DeltaClassicKeyIndex;
+class FileSystem;
+class NodeStatistics;
+struct DeltaClassicSnapshot;
 
 class DeltaClassicTableEntry : public TableCatalogEntry {
 public:
@@ -14,21 +27,148 @@ public:
 	                       const string &delta_table_path);
 
 	string delta_table_path;
+	//! Attach timings, binds and scan sizes (delta_classic_stats)
+	DeltaClassicStats stats;
 
 public:
 	unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id) override;
 	TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override;
 	TableStorageInfo GetStorageInfo(ClientContext &context) override;
 
+	//! Attaches the internal delta database ahead of the first query (PREWARM)
+	void Prewarm(ClientContext &context);
+	//! Marks the table as used by a running query, which keeps it from being evicted until ReleaseScan
+	void AcquireScan();
+	void ReleaseScan();
+	//! Detaches the internal delta database if no running query uses it (MAX_ATTACHED_TABLES).
+	//! The next bind attaches it again.
+	bool TryEvict(ClientContext &context);
+	//! Replaces a snapshot older than MAX_STALENESS: attaches the latest version as a new internal delta database
+	//! and switches binds over to it. Queries bound to the replaced database keep reading it until they finish.
+	void RefreshSnapshot(ClientContext &context);
+	//! Detaches the internal delta databases replaced by RefreshSnapshot once no running query uses the table.
+	//! Returns false if some are still in use.
+	bool DetachReplaced(ClientContext &context);
+	//! Drops the table's references to its internal delta databases when the catalog is detached. With HANDOFF,
+	//! the current one is handed off to the snapshot registry instead; returns whether it was.
+	bool DetachInternalDatabases(ClientContext &context);
+	//! Tick of the most recent bind, for least-recently-used eviction
+	idx_t GetLastUsed() const;
+	//! Fills in the columns from the schema in the Delta log, without attaching the table. Does nothing once
+	//! the columns are known.
+	void LoadColumns(DatabaseInstance &db, FileSystem &fs);
+	//! Snapshot read from the Delta log (at the pinned version, if known), or nullptr if the log cannot be read
+	shared_ptr<DeltaClassicSnapshot> GetSnapshot(ClientContext &context);
+	//! The snapshot a scan bound against scanned_table reads: the pinned one, or the version the transaction's first
+	//! bind scans when the catalog does not pin snapshots. Returns nullptr if it cannot be determined.
+	shared_ptr<DeltaClassicSnapshot> GetScanSnapshot(ClientContext &context, TableCatalogEntry &scanned_table);
+	//! The snapshot a rewrite replacing a whole scan of scanned_table answers from: the one the scan reads, or the
+	//! latest version for a statement outside an explicit transaction whose scan opens the latest version itself.
+	//! Returns nullptr if neither is known.
+	shared_ptr<DeltaClassicSnapshot> GetRewriteSnapshot(ClientContext &context, TableCatalogEntry &scanned_table);
+	//! Row count from the add actions' numRecords; exact when the scan reads the same snapshot
+	unique_ptr<NodeStatistics> GetCardinality(ClientContext &context, TableCatalogEntry &scanned_table);
+	//! The key index of a column built by delta_classic_build_index, or nullptr if there is none. Read from storage
+	//! on first use; the result, including its absence, is kept until SetKeyIndex replaces it.
+	shared_ptr<DeltaClassicKeyIndex> GetKeyIndex(ClientContext &context, const string &column);
+	void SetKeyIndex(shared_ptr<DeltaClassicKeyIndex> index);
+	//! Replaces the table's copy in memory (CACHE_SMALL_TABLES), or clears it if collection is nullptr. Called by the
+	//! catalog, which accounts for the memory of all copies.
+	void SetMaterialized(shared_ptr<ColumnDataCollection> collection, int64_t version);
+	//! Tick of the most recent scan of the copy in memory, for least-recently-used eviction
+	idx_t GetMaterializedLastUsed() const;
+	//! Column min/max statistics from the Delta log, if they describe exactly what the scan reads
+	unique_ptr<BaseStatistics> GetScanStatistics(ClientContext &context, TableCatalogEntry &scanned_table,
+	                                             column_t column_id);
+
 private:
-	//! Attaches the internal delta database using the programmatic API (safe during binding)
+	//! Attaches the internal delta database once; concurrent callers share a single attach
 	void EnsureAttached(ClientContext &context);
-	//! Returns the internal table entry from the attached delta database
-	TableCatalogEntry &GetInternalTableEntry(ClientContext &context);
+	//! Attaches the table as an internal delta database using the programmatic API (safe during binding), or
+	//! shares the one another catalog pinned at the latest version. Sets db_name to the database's name, base_name
+	//! unless that is taken. Returns the version the attach pinned, or -1 if it is not known.
+	int64_t AttachInternalDatabase(ClientContext &context, const string &base_name, string &db_name);
+	//! Releases the current and replaced internal delta databases; attach_lock must be held
+	void ReleaseInternalDatabases(ClientContext &context);
+	//! Returns the internal table entry from the attached delta database. Without pinning, the entry reads the latest
+	//! version at the time of the call. In explicit transactions and with CACHE_SMALL_TABLES, that version is listed
+	//! and stored in scan_version; otherwise scan_version stays -1 (as it does if the version cannot be determined).
+	TableCatalogEntry &GetInternalTableEntry(ClientContext &context, int64_t &scan_version);
+	//! Looks up the table in the internal delta database, which must already be attached, read at at_version if it
+	//! is not negative (AS_OF_TIMESTAMP reads the pinned version)
+	TableCatalogEntry &FindInternalTableEntry(ClientContext &context, int64_t at_version = -1);
+	//! Finds the table in an internal delta database, read at at_version if it is not negative
+	static TableCatalogEntry &LookupInternalTable(ClientContext &context, AttachedDatabase &db,
+	                                              int64_t at_version = -1);
+	//! Reads the footers of the snapshot's data files ahead of the first scan (PREFETCH_FOOTERS)
+	void PrefetchFooters(ClientContext &context);
+	//! Schedules a background RefreshSnapshot once the pinned snapshot is older than MAX_STALENESS
+	void ScheduleRefreshIfStale();
+	//! Takes over the columns reported by the delta extension
+	void SyncColumns(const ColumnList &internal_columns);
+	//! Snapshot at a version read from the log (or the one read last, if it is that version); nullptr on failure
+	shared_ptr<DeltaClassicSnapshot> GetSnapshotAt(ClientContext &context, int64_t version);
+	//! Latest version in the table's _delta_log, or -1 if it cannot be determined
+	int64_t TryGetLatestVersion(ClientContext &context);
+	//! Whether a snapshot read from the log is exactly the one a scan bound against scanned_table reads
+	bool SnapshotMatchesScan(TableCatalogEntry &scanned_table, const DeltaClassicSnapshot &current);
+	//! The table's copy in the REPLICA database, if it has one with the same columns as this entry
+	optional_ptr<TableCatalogEntry> GetReplicaTable(ClientContext &context);
+	//! The table materialized in memory at the version a scan of scanned_table reads, if its data files are
+	//! smaller than CACHE_SMALL_TABLES; reads the table on first use of a version, once for all concurrent binds
+	//! and without holding materialized_lock. Returns nullptr otherwise.
+	shared_ptr<ColumnDataCollection> GetMaterialized(ClientContext &context, TableCatalogEntry &scanned_table);
 
 	//! Internal database name used for ATTACH
 	string internal_db_name;
-	bool is_attached;
+	//! Name of the internal database binds currently use: internal_db_name, a generation attached by
+	//! RefreshSnapshot, or a database shared with another catalog
+	string current_db_name;
+	//! Internal databases replaced by RefreshSnapshot that are not detached yet
+	vector<string> replaced_db_names;
+	idx_t generation;
+	//! When the current internal database was attached, in microseconds of the steady clock
+	atomic<int64_t> attached_at;
+	//! Whether a RefreshSnapshot is scheduled or running
+	atomic<bool> refresh_pending;
+	mutex attach_lock;
+	atomic<bool> is_attached;
+	//! The attach in progress, if any; valid only while a caller is attaching
+	std::shared_future<void> attach_flight;
+	//! The internal delta database, resolved on first use
+	shared_ptr<AttachedDatabase> internal_db;
+	//! The internal table entry, cached when the snapshot is pinned. Replaced together with pinned_version
+	//! (under snapshot_lock) by RefreshSnapshot.
+	atomic<TableCatalogEntry *> cached_internal_table;
+	//! Number of running queries that bound this table
+	atomic<idx_t> active_scans;
+	atomic<idx_t> last_used;
+
+	mutex columns_lock;
+	//! Whether the columns were read from the log or taken from the delta extension
+	bool columns_loaded;
+	//! Whether the columns are known to match the delta extension's for good (pinned snapshots)
+	atomic<bool> columns_synced;
+
+	//! Version pinned by the internal delta attach (or resolved from AS_OF_TIMESTAMP), or -1 if unknown (unpinned,
+	//! or a commit raced the attach)
+	int64_t pinned_version;
+	mutex snapshot_lock;
+	shared_ptr<DeltaClassicSnapshot> snapshot;
+	bool snapshot_failed;
+
+	mutex key_index_lock;
+	//! Key indexes by column; nullptr for columns known to have none
+	case_insensitive_map_t<shared_ptr<DeltaClassicKeyIndex>> key_indexes;
+
+	//! The table read into memory (CACHE_SMALL_TABLES) at materialized_version
+	mutex materialized_lock;
+	shared_ptr<ColumnDataCollection> materialized;
+	int64_t materialized_version;
+	//! The read in progress, if any, and the version it reads
+	std::shared_future<shared_ptr<ColumnDataCollection>> materialize_flight;
+	int64_t materialize_flight_version;
+	atomic<idx_t> materialized_last_used;
 };
 
 } // namespace duckdb
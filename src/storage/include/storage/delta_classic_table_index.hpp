@@ -0,0 +1,52 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+struct DeltaClassicDiscoveredTable;
+
+//! The discovered tables of a schema in compact form. Names and the last segments of paths are stored back to back
+//! in one character arena and the directories of paths are interned, so a table costs its name, the last segment of
+//! its path and a 20-byte entry instead of a catalog entry. Lookups binary search the entries, which are sorted by
+//! case-insensitive name.
+class DeltaClassicTableIndex {
+public:
+	//! Replaces the contents with a listing. Of tables whose names differ only in case, the last one is kept.
+	void Assign(const vector<DeltaClassicDiscoveredTable> &tables);
+	//! Adds a table, or replaces the path of the table of the same name (case-insensitively)
+	void Add(const string &name, const string &path);
+	//! Finds a table by name, case-insensitively. listed_name receives the name as listed.
+	bool Find(const string &name, string &listed_name, string &path) const;
+	idx_t Count() const;
+	//! Calls callback(name, path) for every table, ordered by name
+	void ForEach(const std::function<void(const string &name, const string &path)> &callback) const;
+
+private:
+	struct Entry {
+		uint32_t name_offset;
+		uint32_t name_length;
+		uint32_t directory_id;
+		uint32_t segment_offset;
+		uint32_t segment_length;
+	};
+
+	Entry MakeEntry(const string &name, const string &path);
+	string GetName(const Entry &entry) const;
+	string GetPath(const Entry &entry) const;
+	//! Position of the first entry not ordered before name; found is set if its name equals name
+	idx_t LowerBound(const string &name, bool &found) const;
+	int CompareName(const Entry &entry, const char *name, idx_t name_length) const;
+
+	//! Names and last path segments of all entries
+	string arena;
+	//! Interned path directories, including the trailing '/'
+	vector<string> directories;
+	unordered_map<string, uint32_t> directory_ids;
+	vector<Entry> entries;
+};
+
+} // namespace duckdb
@@ -4,27 +4,63 @@
 #include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/common/mutex.hpp"
 #include "storage/delta_classic_table_entry.hpp"
+#include "storage/delta_classic_table_index.hpp"
 
 namespace duckdb {
 
 class DeltaClassicCatalog;
+class FileSystem;
 class DeltaClassicSchemaEntry;
+struct DeltaClassicDiscoveredTable;
+struct DeltaClassicRefreshResult;
 struct EntryLookupInfo;
 
+//! The tables of a schema. Discovered tables are kept in a compact index; the catalog entry of a table is created on
+//! its first lookup (or when the schema is scanned), so schemas with many tables are cheap until queried.
 class DeltaClassicTableSet {
 public:
 	explicit DeltaClassicTableSet(DeltaClassicSchemaEntry &schema);
 
 	optional_ptr<CatalogEntry> GetEntry(ClientContext &context, const EntryLookupInfo &lookup);
+	//! Looks a table up using only the file system, so it can run on any thread
+	optional_ptr<DeltaClassicTableEntry> GetEntry(FileSystem &fs, const string &name);
 	void Scan(ClientContext &context, const std::function<void(CatalogEntry &)> &callback);
 	void ScanNoContext(const std::function<void(CatalogEntry &)> &callback);
+	//! Calls back with the name of every table, listing the schema directory first if needed. Unlike Scan, it
+	//! neither creates catalog entries nor reads the tables' logs.
+	void ScanNames(ClientContext &context, const std::function<void(const string &)> &callback);
+	//! Returns every table of the schema, listing the schema directory first if needed
+	vector<reference<DeltaClassicTableEntry>> GetEntries(ClientContext &context);
+	//! Returns the tables whose catalog entry was created (i.e. that were looked up), ordered by name
+	vector<reference<DeltaClassicTableEntry>> GetLoadedEntries();
+
+	//! Takes the tables found by catalog-level discovery as the complete set, so the schema directory is not listed
+	void LoadListing(const vector<DeltaClassicDiscoveredTable> &listed);
+	//! Whether the set holds anything a refresh must diff, i.e. the schema was listed or a table looked up
+	bool NeedsRefresh();
+	//! Diffs the set against a fresh listing of the schema directory. Unchanged entries are kept (with their
+	//! attachments); entries no longer listed are moved to retired, as running queries may still use them.
+	void Refresh(const vector<DeltaClassicDiscoveredTable> &listed, DeltaClassicRefreshResult &result,
+	             vector<unique_ptr<DeltaClassicTableEntry>> &retired);
 
 private:
-	void LoadEntries(ClientContext &context);
+	void LoadEntries(FileSystem &fs);
+	//! The catalog entry of an indexed table, created on first use; entry_lock must be held
+	DeltaClassicTableEntry &GetOrCreateEntry(const string &name, const string &path);
+	//! The catalog entries of all indexed tables, in name order; entry_lock must be held
+	vector<reference<DeltaClassicTableEntry>> GetAllEntries();
+	//! Resolves a single table by checking for its _delta_log directly, without listing the schema
+	optional_ptr<DeltaClassicTableEntry> ProbeEntry(FileSystem &fs, const string &name);
+	//! Reads the schema of every table from its Delta log
+	void LoadColumns(ClientContext &context);
 
 	DeltaClassicSchemaEntry &schema;
 	mutex entry_lock;
+	//! Every known table. Until the schema directory is listed, only the tables found by point lookups.
+	DeltaClassicTableIndex index;
+	//! Catalog entries of the indexed tables that were looked up
 	case_insensitive_map_t<unique_ptr<DeltaClassicTableEntry>> tables;
+	//! Whether the schema directory was listed
 	bool is_loaded;
 };
 
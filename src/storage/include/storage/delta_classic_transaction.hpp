@@ -1,10 +1,23 @@
 #pragma once
 
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/reference_map.hpp"
 #include "duckdb/transaction/transaction.hpp"
 
 namespace duckdb {
 
 class DeltaClassicCatalog;
+class DeltaClassicTableEntry;
+class TableCatalogEntry;
+
+//! What a transaction reads of one delta_classic table, fixed when the transaction first touches it
+struct DeltaClassicTransactionTable {
+	//! The internal delta table every statement of the transaction scans
+	optional_ptr<TableCatalogEntry> internal_table;
+	//! Version internal_table reads when the catalog does not pin snapshots, resolved by the first bind of an explicit
+	//! transaction; -1 if unknown, which turns off the log-based statistics for the table in this transaction
+	int64_t scan_version = -1;
+};
 
 class DeltaClassicTransaction : public Transaction {
 public:
@@ -12,6 +25,14 @@ public:
 	~DeltaClassicTransaction() override;
 
 	static DeltaClassicTransaction &Get(ClientContext &context, Catalog &catalog);
+
+	//! Returns the state of a table in this transaction. The first call marks the table as in use until the
+	//! transaction ends, so the internal database it reads is neither evicted nor replaced meanwhile.
+	DeltaClassicTransactionTable &GetTable(DeltaClassicTableEntry &table);
+
+private:
+	mutex tables_lock;
+	reference_map_t<DeltaClassicTableEntry, DeltaClassicTransactionTable> tables;
 };
 
 } // namespace duckdb
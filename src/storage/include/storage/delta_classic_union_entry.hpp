@@ -0,0 +1,70 @@
+#pragma once
+
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "storage/delta_classic_schema_entry.hpp"
+
+namespace duckdb {
+
+class DeltaClassicTableEntry;
+class DeltaClassicUnionTableEntry;
+
+//! Name of the virtual schema whose tables combine the tables of the same name in every schema
+static constexpr const char *DELTA_CLASSIC_UNION_SCHEMA = "__all__";
+
+//! The __all__ schema. Looking up a table in it finds the tables of that name in every schema (in parallel)
+//! without attaching them. It is not listed among the catalog's schemas.
+class DeltaClassicUnionSchemaEntry : public DeltaClassicSchemaEntry {
+public:
+	DeltaClassicUnionSchemaEntry(Catalog &catalog, CreateSchemaInfo &info);
+
+public:
+	optional_ptr<CatalogEntry> LookupEntry(CatalogTransaction transaction,
+	                                       const EntryLookupInfo &lookup_info) override;
+	void Scan(ClientContext &context, CatalogType type,
+	          const std::function<void(CatalogEntry &)> &callback) override;
+	void Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+	SimilarCatalogEntry GetSimilarEntry(CatalogTransaction transaction, const EntryLookupInfo &lookup_info) override;
+
+private:
+	mutex union_lock;
+	case_insensitive_map_t<unique_ptr<DeltaClassicUnionTableEntry>> union_tables;
+	//! Union tables replaced because their columns changed, kept alive for the queries bound to them
+	vector<unique_ptr<DeltaClassicUnionTableEntry>> retired_tables;
+};
+
+//! A table of the __all__ schema: the union of the tables of one name across schemas, with the schema name as the
+//! virtual column schema_name. Its columns are the union by name of the columns of the tables, and columns a schema's
+//! table lacks read as NULL.
+//! The scan is a placeholder that the optimizer extension expands into one scan per schema, after dropping the
+//! schemas that filters on schema_name exclude.
+class DeltaClassicUnionTableEntry : public TableCatalogEntry {
+public:
+	static constexpr column_t SCHEMA_NAME_COLUMN = VIRTUAL_COLUMN_START;
+
+	DeltaClassicUnionTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info);
+
+public:
+	unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id) override;
+	TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override;
+	TableStorageInfo GetStorageInfo(ClientContext &context) override;
+	virtual_column_map_t GetVirtualColumns() const override;
+
+	//! Tables of this name found by the most recent lookup, ordered by schema name
+	void SetMembers(vector<reference<DeltaClassicTableEntry>> members);
+
+private:
+	mutex members_lock;
+	vector<reference<DeltaClassicTableEntry>> members;
+};
+
+//! Bind data of the placeholder scan of a DeltaClassicUnionTableEntry
+struct DeltaClassicUnionScanData : public TableFunctionData {
+	explicit DeltaClassicUnionScanData(vector<reference<DeltaClassicTableEntry>> members);
+
+	vector<reference<DeltaClassicTableEntry>> members;
+
+	static constexpr const char *FUNCTION_NAME = "delta_classic_union_scan";
+};
+
+} // namespace duckdb
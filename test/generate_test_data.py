@@ -5,9 +5,11 @@ Usage:
     pip install deltalake pyarrow
     python test/generate_test_data.py
 
-Creates test/data/ with Delta tables in two layouts:
+Creates test/data/ with Delta tables in three layouts:
   - single_schema/  (tables directly under root)
   - multi_schema/   (schema dirs containing table dirs)
+  - nested/         (tables two directory levels below root)
+  - partitioned/    (a table partitioned by region, written in two commits)
 """
 import os
 import shutil
@@ -87,8 +89,64 @@ def generate_multi_schema():
     make_table(os.path.join(root, "schema2", "table_z"), t_z)
 
 
+def generate_nested():
+    """
+    Layout:
+      test/data/nested/
+        region1/tenant_a/
+          orders/_delta_log/...
+          customers/_delta_log/...
+        region2/tenant_b/
+          orders/_delta_log/...
+    """
+    root = os.path.join(BASE, "nested")
+
+    orders_a = pa.table({
+        "id": pa.array([1, 2, 3, 4, 5], type=pa.int64()),
+        "region": pa.array(["east", "west", "east", "west", "east"], type=pa.string()),
+        "amount": pa.array([100, 200, 150, 250, 300], type=pa.int64()),
+    })
+    make_table(os.path.join(root, "region1", "tenant_a", "orders"), orders_a)
+
+    customers_a = pa.table({
+        "id": pa.array([100, 200], type=pa.int64()),
+        "category": pa.array(["x", "y"], type=pa.string()),
+    })
+    make_table(os.path.join(root, "region1", "tenant_a", "customers"), customers_a)
+
+    orders_b = pa.table({
+        "id": pa.array([10, 20, 30], type=pa.int64()),
+        "label": pa.array(["foo", "bar", "baz"], type=pa.string()),
+    })
+    make_table(os.path.join(root, "region2", "tenant_b", "orders"), orders_b)
+
+
+def generate_partitioned():
+    """
+    Layout:
+      test/data/partitioned/
+        events/
+          _delta_log/...      (version 0 adds region=eu, version 1 adds region=us)
+          region=eu/...
+          region=us/...
+    """
+    root = os.path.join(BASE, "partitioned")
+    path = os.path.join(root, "events")
+
+    for mode, region in [("overwrite", "eu"), ("append", "us")]:
+        events = pa.table({
+            "id": pa.array([1, 2, 3], type=pa.int64()),
+            "name": pa.array(["alice", "bob", "charlie"], type=pa.string()),
+            "value": pa.array([10.0, 20.0, 30.0], type=pa.float64()),
+            "region": pa.array([region] * 3, type=pa.string()),
+        })
+        write_deltalake(path, events, mode=mode, partition_by=["region"])
+
+
 if __name__ == "__main__":
     clean()
     generate_single_schema()
     generate_multi_schema()
+    generate_nested()
+    generate_partitioned()
     print(f"Test data generated in {BASE}/")
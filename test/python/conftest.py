@@ -1,4 +1,8 @@
+import json
 import os
+import shutil
+import time
+
 import pytest
 import duckdb
 
@@ -28,3 +32,94 @@ def conn(extension_path):
     con.execute(f"INSTALL '{extension_path}'")
     yield con
     con.close()
+
+
+@pytest.fixture
+def copy_table(tmp_path):
+    """Copies a directory of test/data to tmp_path/lakehouse, so a test can commit to it, and returns the copy."""
+
+    def copy(source):
+        path = tmp_path / "lakehouse"
+        shutil.copytree(f"test/data/{source}", path)
+        return path
+
+    return copy
+
+
+@pytest.fixture
+def commit():
+    """Writes the given actions as a commit of the table."""
+
+    def write(table_path, version, actions):
+        log_file = table_path / "_delta_log" / f"{version:020d}.json"
+        log_file.write_text("".join(json.dumps(action) + "\n" for action in actions))
+
+    return write
+
+
+@pytest.fixture
+def append_commit(commit):
+    """Commits a copy of the table's data file, holding num_records rows, as version 1."""
+
+    def append(table_path, num_records):
+        source = next(table_path.glob("*.parquet"))
+        shutil.copy(source, table_path / "part-appended.parquet")
+        add = {
+            "add": {
+                "path": "part-appended.parquet",
+                "partitionValues": {},
+                "size": source.stat().st_size,
+                "modificationTime": int(time.time() * 1000),
+                "dataChange": True,
+                "stats": json.dumps({"numRecords": num_records}),
+            }
+        }
+        commit(table_path, 1, [add])
+
+    return append
+
+
+@pytest.fixture
+def add_column(commit):
+    """Commits a schema change adding a column, without writing any data."""
+
+    def add(table_path, version, name, type_name):
+        first_commit = (table_path / "_delta_log" / f"{0:020d}.json").read_text().splitlines()
+        metadata = next(json.loads(line) for line in first_commit if "metaData" in line)
+        schema = json.loads(metadata["metaData"]["schemaString"])
+        schema["fields"].append({"name": name, "type": type_name, "nullable": True, "metadata": {}})
+        metadata["metaData"]["schemaString"] = json.dumps(schema)
+        commit(table_path, version, [metadata])
+
+    return add
+
+
+@pytest.fixture
+def enable_logging():
+    def enable(conn):
+        conn.execute("SET enable_logging = true")
+        conn.execute("SET logging_level = 'info'")
+
+    return enable
+
+
+@pytest.fixture
+def count_logs():
+    """Number of log messages matching a LIKE pattern."""
+
+    def count(conn, pattern):
+        return conn.execute("SELECT COUNT(*) FROM duckdb_logs WHERE message LIKE ?", [pattern]).fetchone()[0]
+
+    return count
+
+
+@pytest.fixture
+def count_internal_databases():
+    """Number of internal delta databases attached by delta_classic catalogs."""
+
+    def count(conn):
+        return conn.execute(
+            "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_%'"
+        ).fetchone()[0]
+
+    return count
@@ -0,0 +1,45 @@
+"""Test AS_OF_TIMESTAMP: reading every table at the version committed at or before a point in time."""
+import datetime
+import json
+import shutil
+
+
+def commit_info(timestamp):
+    return {"commitInfo": {"timestamp": timestamp, "operation": "WRITE"}}
+
+
+def as_of(timestamp_ms):
+    moment = datetime.datetime.fromtimestamp(timestamp_ms / 1000, datetime.timezone.utc)
+    return moment.strftime("%Y-%m-%d %H:%M:%S.%f")
+
+
+def test_skewed_commit_timestamps(conn, copy_table, commit):
+    path = copy_table("single_schema")
+    table_path = path / "table_a"
+    first_commit = (table_path / "_delta_log" / f"{0:020d}.json").read_text().splitlines()
+    t0 = next(json.loads(line) for line in first_commit if "commitInfo" in line)["commitInfo"]["timestamp"]
+
+    source = next(table_path.glob("*.parquet"))
+    shutil.copy(source, table_path / "part-appended.parquet")
+    add = {
+        "add": {
+            "path": "part-appended.parquet",
+            "partitionValues": {},
+            "size": source.stat().st_size,
+            "modificationTime": t0 + 10000,
+            "dataChange": True,
+            "stats": json.dumps({"numRecords": 3}),
+        }
+    }
+    commit(table_path, 1, [commit_info(t0 + 10000), add])
+    # Written by a client whose clock is behind: counts as committed no earlier than version 1
+    commit(table_path, 2, [commit_info(t0 + 5000)])
+    commit(table_path, 3, [commit_info(t0 + 20000)])
+
+    conn.execute(f"ATTACH '{path}' AS tdb (TYPE delta_classic, AS_OF_TIMESTAMP '{as_of(t0 + 6000)}')")
+    assert conn.execute("SELECT COUNT(*) FROM tdb.main.table_a").fetchone()[0] == 3
+    conn.execute("DETACH tdb")
+
+    conn.execute(f"ATTACH '{path}' AS tdb (TYPE delta_classic, AS_OF_TIMESTAMP '{as_of(t0 + 15000)}')")
+    assert conn.execute("SELECT COUNT(*) FROM tdb.main.table_a").fetchone()[0] == 6
+    conn.execute("DETACH tdb")
@@ -0,0 +1,85 @@
+"""Test CACHE_SMALL_TABLES: small tables are read into memory once per version."""
+import concurrent.futures
+
+import duckdb
+import pytest
+
+
+def count_cache_logs(conn):
+    return conn.execute(
+        "SELECT COUNT(*) FROM duckdb_logs WHERE message LIKE 'delta_classic: cached%table_a%'"
+    ).fetchone()[0]
+
+
+def test_small_table_is_read_once(conn, enable_logging):
+    enable_logging(conn)
+    conn.execute("ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, PIN_SNAPSHOT, CACHE_SMALL_TABLES '64MB')")
+
+    expected = conn.execute("SELECT * FROM cdb.main.table_a ORDER BY id").fetchall()
+    assert len(expected) == 3
+    assert conn.execute("SELECT * FROM cdb.main.table_a ORDER BY id").fetchall() == expected
+    assert conn.execute("SELECT id FROM cdb.main.table_a WHERE id > 1 ORDER BY id").fetchall() == [(2,), (3,)]
+    assert count_cache_logs(conn) == 1
+
+    conn.execute("DETACH cdb")
+
+
+def test_large_table_is_not_cached(conn, enable_logging):
+    enable_logging(conn)
+    conn.execute("ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, PIN_SNAPSHOT, CACHE_SMALL_TABLES '1 byte')")
+
+    assert len(conn.execute("SELECT * FROM cdb.main.table_a").fetchall()) == 3
+    assert count_cache_logs(conn) == 0
+
+    conn.execute("DETACH cdb")
+
+
+def test_new_version_invalidates_cache(conn, copy_table, append_commit, enable_logging):
+    enable_logging(conn)
+    path = copy_table("single_schema")
+    conn.execute(f"ATTACH '{path}' AS cdb (TYPE delta_classic, CACHE_SMALL_TABLES '64MB')")
+
+    assert len(conn.execute("SELECT * FROM cdb.main.table_a").fetchall()) == 3
+    append_commit(path / "table_a", 3)
+    assert len(conn.execute("SELECT * FROM cdb.main.table_a").fetchall()) == 6
+    assert count_cache_logs(conn) == 2
+
+    conn.execute("DETACH cdb")
+
+
+def test_concurrent_binds_read_table_once(conn, enable_logging):
+    enable_logging(conn)
+    conn.execute("ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, PIN_SNAPSHOT, CACHE_SMALL_TABLES '64MB')")
+
+    def scan(cursor):
+        return len(cursor.execute("SELECT * FROM cdb.main.table_a").fetchall())
+
+    cursors = [conn.cursor() for _ in range(8)]
+    with concurrent.futures.ThreadPoolExecutor(max_workers=8) as pool:
+        assert list(pool.map(scan, cursors)) == [3] * 8
+    assert count_cache_logs(conn) == 1
+
+    conn.execute("DETACH cdb")
+
+
+def test_memory_budget_drops_copies(conn, enable_logging):
+    enable_logging(conn)
+    conn.execute(
+        "ATTACH 'test/data/single_schema' AS cdb "
+        "(TYPE delta_classic, PIN_SNAPSHOT, CACHE_SMALL_TABLES '64MB', CACHE_SMALL_TABLES_SIZE '1 byte')"
+    )
+
+    # Every copy exceeds the budget, so it only serves the scan that read it
+    assert len(conn.execute("SELECT * FROM cdb.main.table_a").fetchall()) == 3
+    assert len(conn.execute("SELECT * FROM cdb.main.table_a").fetchall()) == 3
+    assert count_cache_logs(conn) == 2
+
+    conn.execute("DETACH cdb")
+
+
+def test_memory_budget_must_be_positive(conn):
+    with pytest.raises(duckdb.InvalidInputException, match="CACHE_SMALL_TABLES_SIZE must be positive"):
+        conn.execute(
+            "ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, CACHE_SMALL_TABLES '64MB', "
+            "CACHE_SMALL_TABLES_SIZE '0 bytes')"
+        )
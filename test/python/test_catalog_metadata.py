@@ -1,5 +1,6 @@
 """Test catalog metadata: duckdb_databases, duckdb_tables, duckdb_schemas, DESCRIBE."""
 
+import duckdb
 import pytest
 
 
@@ -41,6 +42,30 @@ def test_describe_single_schema_table(conn):
     conn.execute("DETACH sdb")
 
 
+def test_browsing_columns_does_not_attach(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/single_schema' AS bdb (TYPE delta_classic)")
+    columns = conn.execute(
+        "SELECT column_name FROM information_schema.columns "
+        "WHERE table_catalog = 'bdb' AND table_name = 'table_a' ORDER BY ordinal_position"
+    ).fetchall()
+    assert [r[0] for r in columns] == ["id", "name", "value"]
+    assert count_internal_databases(conn) == 0
+
+    # DESCRIBE binds a scan of the table, which attaches it
+    cols = conn.execute("DESCRIBE bdb.main.table_a").fetchall()
+    assert [r[0] for r in cols] == ["id", "name", "value"]
+    assert count_internal_databases(conn) == 1
+    conn.execute("DETACH bdb")
+
+
+def test_misspelled_table_suggests_name(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/single_schema' AS tdb (TYPE delta_classic)")
+    with pytest.raises(duckdb.CatalogException, match="table_a"):
+        conn.execute("SELECT * FROM tdb.main.table_aa")
+    assert count_internal_databases(conn) == 0
+    conn.execute("DETACH tdb")
+
+
 def test_multi_schema_tables_in_correct_schemas(conn):
     conn.execute("ATTACH 'test/data/multi_schema' AS mdb (TYPE delta_classic)")
     rows = conn.execute(
@@ -58,3 +83,26 @@ def test_pin_snapshot_option_accepted(conn):
     count = conn.execute("SELECT COUNT(*) FROM pindb.main.table_a").fetchone()[0]
     assert count == 3
     conn.execute("DETACH pindb")
+
+
+def test_columns_from_long_log_without_checkpoint(conn, tmp_path):
+    import json
+    import shutil
+
+    path = tmp_path / "lakehouse"
+    shutil.copytree("test/data/single_schema", path)
+    # Commits after the first one only hold commitInfo, so the metadata is in version 0
+    log = path / "table_a" / "_delta_log"
+    for version in range(1, 40):
+        commit = {"commitInfo": {"timestamp": 1700000000000 + version, "operation": "OPTIMIZE"}}
+        (log / f"{version:020d}.json").write_text(json.dumps(commit) + "\n")
+
+    conn.execute(f"ATTACH '{path}' AS ldb (TYPE delta_classic, DISCOVERY_THREADS 8)")
+    columns = conn.execute(
+        "SELECT column_name FROM duckdb_columns() WHERE database_name = 'ldb' AND table_name = 'table_a' "
+        "ORDER BY column_index"
+    ).fetchall()
+    assert [r[0] for r in columns] == ["id", "name", "value"]
+    attached = conn.execute("SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_ldb_%'")
+    assert attached.fetchone()[0] == 0
+    conn.execute("DETACH ldb")
@@ -0,0 +1,53 @@
+"""Test delta_classic_changes and delta_classic_removed_files over commits that remove and rewrite files."""
+
+import shutil
+
+
+EU_FILE = "region=eu/part-00000-3f1c2a9e-6b1d-4f0e-9a57-2d8e1c4b7a10-c000.snappy.parquet"
+
+
+def test_removed_files_and_compaction(conn, copy_table, commit):
+    table_path = copy_table("partitioned") / "events"
+    # Version 2 deletes the eu partition
+    commit(table_path, 2, [{"remove": {"path": EU_FILE, "size": 1134, "dataChange": True}}])
+    # Version 3 rewrites the us file without changing rows, like a compaction
+    us_file = next((table_path / "region=us").glob("*.parquet"))
+    shutil.copy(us_file, table_path / "region=us" / "compacted.parquet")
+    commit(
+        table_path,
+        3,
+        [
+            {"remove": {"path": f"region=us/{us_file.name}", "dataChange": False}},
+            {
+                "add": {
+                    "path": "region=us/compacted.parquet",
+                    "partitionValues": {"region": "us"},
+                    "size": us_file.stat().st_size,
+                    "modificationTime": 0,
+                    "dataChange": False,
+                }
+            },
+        ],
+    )
+    conn.execute(f"ATTACH '{table_path.parent}' AS cdb (TYPE delta_classic)")
+
+    removed = conn.execute("SELECT _commit_version, path, size FROM delta_classic_removed_files('cdb.main.events', 2)")
+    assert removed.fetchall() == [(2, f"{table_path}/{EU_FILE}", 1134)]
+
+    # Neither the delete nor the compaction added rows
+    assert conn.execute("SELECT COUNT(*) FROM delta_classic_changes('cdb.main.events', 2)").fetchone()[0] == 0
+    assert conn.execute("SELECT COUNT(*) FROM delta_classic_changes('cdb.main.events', 1, 3)").fetchone()[0] == 3
+
+    conn.execute("DETACH cdb")
+
+
+def test_changes_after_added_column(conn, copy_table, add_column):
+    table_path = copy_table("partitioned") / "events"
+    add_column(table_path, 2, "score", "long")
+    conn.execute(f"ATTACH '{table_path.parent}' AS cdb (TYPE delta_classic)")
+
+    # No data file holds the new column yet
+    rows = conn.execute("SELECT id, score FROM delta_classic_changes('cdb.main.events', 0) ORDER BY id").fetchall()
+    assert len(rows) == 6
+    assert all(score is None for _, score in rows)
+    conn.execute("DETACH cdb")
@@ -0,0 +1,80 @@
+"""Test that concurrent first access to a table attaches it exactly once."""
+
+import threading
+
+
+THREADS = 32
+
+
+def count_attach_logs(conn, table):
+    return conn.execute(
+        "SELECT COUNT(*) FROM duckdb_logs WHERE message LIKE 'delta_classic: attached%' AND message LIKE ?",
+        [f"%{table}%"],
+    ).fetchone()[0]
+
+
+def run_concurrently(conn, query):
+    barrier = threading.Barrier(THREADS)
+    results = [None] * THREADS
+    errors = []
+
+    def worker(i):
+        cursor = conn.cursor()
+        try:
+            barrier.wait()
+            results[i] = cursor.execute(query).fetchall()
+        except Exception as e:
+            errors.append(e)
+        finally:
+            cursor.close()
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(THREADS)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert errors == []
+    return results
+
+
+def test_concurrent_binds_attach_once(conn):
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute("ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic)")
+
+    results = run_concurrently(conn, "SELECT SUM(id) FROM cdb.main.table_a")
+    assert all(r == [(6,)] for r in results)
+
+    assert count_attach_logs(conn, "table_a") == 1
+    internal = conn.execute(
+        "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_cdb_%'"
+    ).fetchone()[0]
+    assert internal == 1
+
+    conn.execute("DETACH cdb")
+
+
+def test_concurrent_binds_attach_once_pinned(conn):
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute("ATTACH 'test/data/multi_schema' AS pdb (TYPE delta_classic, PIN_SNAPSHOT)")
+
+    results = run_concurrently(conn, "SELECT SUM(id) FROM pdb.schema1.table_x")
+    assert len(set(str(r) for r in results)) == 1
+
+    assert count_attach_logs(conn, "table_x") == 1
+
+    conn.execute("DETACH pdb")
+    orphaned = conn.execute(
+        "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_pdb_%'"
+    ).fetchone()[0]
+    assert orphaned == 0
+
+
+def test_concurrent_binds_wait_for_prewarm(conn):
+    conn.execute("ATTACH 'test/data/multi_schema' AS wdb (TYPE delta_classic, PREWARM)")
+
+    results = run_concurrently(conn, "SELECT COUNT(*) FROM wdb.schema2.table_z")
+    assert len(set(str(r) for r in results)) == 1
+
+    conn.execute("DETACH wdb")
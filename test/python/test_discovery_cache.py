@@ -0,0 +1,47 @@
+"""Test warm attaches from DISCOVERY_CACHE manifests."""
+import shutil
+
+
+def list_tables(conn, db):
+    return conn.execute(
+        f"SELECT schema_name, table_name FROM duckdb_tables() WHERE database_name = '{db}' ORDER BY ALL"
+    ).fetchall()
+
+
+def test_corrupt_manifest_is_a_cache_miss(conn, tmp_path):
+    cache = tmp_path / "cache"
+    conn.execute(f"ATTACH 'test/data/multi_schema' AS cold (TYPE delta_classic, DISCOVERY_CACHE '{cache}')")
+    expected = list_tables(conn, "cold")
+    conn.execute("DETACH cold")
+
+    manifest = next(cache.glob("*.manifest"))
+    header = manifest.read_text().split("\n")[0]
+    # A field that does not parse as a number
+    manifest.write_text(header + "\nlisting\tnot-a-number\n")
+
+    conn.execute(f"ATTACH 'test/data/multi_schema' AS warm (TYPE delta_classic, DISCOVERY_CACHE '{cache}')")
+    assert list_tables(conn, "warm") == expected
+    conn.execute("DETACH warm")
+    # The manifest was written again from the full discovery
+    assert "schema\tschema1" in manifest.read_text()
+
+
+def test_directory_that_becomes_a_table_is_found(conn, copy_table, tmp_path):
+    path = copy_table("multi_schema")
+    cache = tmp_path / "cache"
+    # Not a table yet: the directory holds data but no _delta_log
+    late = path / "schema1" / "table_late"
+    late.mkdir()
+    for data_file in (path / "schema1" / "table_x").glob("*.parquet"):
+        shutil.copy(data_file, late)
+    conn.execute(f"ATTACH '{path}' AS cold (TYPE delta_classic, DISCOVERY_CACHE '{cache}')")
+    assert ("schema1", "table_late") not in list_tables(conn, "cold")
+    conn.execute("DETACH cold")
+
+    # The listing of schema1 stays the same
+    shutil.copytree(path / "schema1" / "table_x" / "_delta_log", late / "_delta_log")
+
+    conn.execute(f"ATTACH '{path}' AS warm (TYPE delta_classic, DISCOVERY_CACHE '{cache}')")
+    assert ("schema1", "table_late") in list_tables(conn, "warm")
+    assert conn.execute("SELECT COUNT(*) FROM warm.schema1.table_late").fetchone()[0] == 5
+    conn.execute("DETACH warm")
@@ -0,0 +1,91 @@
+"""Test that HANDOFF passes pinned snapshots from a detached catalog to the next one."""
+import time
+
+import pytest
+
+
+def test_reattach_takes_over_snapshot(conn, enable_logging, count_logs, count_internal_databases):
+    enable_logging(conn)
+    conn.execute("ATTACH 'test/data/multi_schema' AS hdb (TYPE delta_classic, HANDOFF '1 minute')")
+    assert conn.execute("SELECT COUNT(*) FROM hdb.schema1.table_x").fetchone()[0] == 5
+
+    conn.execute("DETACH hdb")
+    assert count_internal_databases(conn) == 1
+    assert count_logs(conn, "delta_classic: detached 1 tables of %, handed off 1") == 1
+
+    conn.execute("ATTACH 'test/data/multi_schema' AS hdb (TYPE delta_classic, HANDOFF '1 minute')")
+    assert conn.execute("SELECT SUM(id) FROM hdb.schema1.table_x").fetchone()[0] == 15
+    assert count_logs(conn, "delta_classic: attached%table_x%") == 1
+    assert count_logs(conn, "delta_classic: shared%table_x%") == 1
+    assert count_internal_databases(conn) == 1
+
+
+def test_attach_or_replace_takes_over_snapshot(conn, enable_logging, count_logs, count_internal_databases):
+    enable_logging(conn)
+    conn.execute("ATTACH 'test/data/multi_schema' AS rdb (TYPE delta_classic, HANDOFF '1 minute')")
+    conn.execute("SELECT COUNT(*) FROM rdb.schema1.table_x").fetchall()
+
+    conn.execute("ATTACH OR REPLACE 'test/data/multi_schema' AS rdb (TYPE delta_classic, PIN_SNAPSHOT)")
+    assert conn.execute("SELECT COUNT(*) FROM rdb.schema1.table_x").fetchone()[0] == 5
+    assert count_logs(conn, "delta_classic: attached%table_x%") == 1
+
+    # Without HANDOFF, the taken over snapshot is detached with the catalog
+    conn.execute("DETACH rdb")
+    assert count_internal_databases(conn) == 0
+
+
+def test_changed_table_is_attached_again(conn, enable_logging, count_logs, append_commit, copy_table):
+    path = copy_table("multi_schema")
+    enable_logging(conn)
+    conn.execute(f"ATTACH '{path}' AS cdb (TYPE delta_classic, HANDOFF '1 minute')")
+    assert conn.execute("SELECT COUNT(*) FROM cdb.schema1.table_x").fetchone()[0] == 5
+    conn.execute("DETACH cdb")
+
+    # The handed off snapshot is no longer the latest version
+    append_commit(path / "schema1" / "table_x", 5)
+
+    conn.execute(f"ATTACH '{path}' AS cdb (TYPE delta_classic, HANDOFF '1 minute')")
+    assert conn.execute("SELECT COUNT(*) FROM cdb.schema1.table_x").fetchone()[0] == 10
+    assert count_logs(conn, "delta_classic: attached%table_x%") == 2
+    assert count_logs(conn, "delta_classic: shared%table_x%") == 0
+
+
+def test_unclaimed_snapshot_expires(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/multi_schema' AS edb (TYPE delta_classic, HANDOFF '10 milliseconds')")
+    conn.execute("SELECT COUNT(*) FROM edb.schema1.table_x").fetchall()
+    conn.execute("DETACH edb")
+    assert count_internal_databases(conn) == 1
+
+    time.sleep(0.1)
+    conn.execute("ATTACH 'test/data/single_schema' AS other (TYPE delta_classic)")
+    conn.execute("DETACH other")
+    assert count_internal_databases(conn) == 0
+
+
+def test_unclaimed_snapshot_expires_without_reattach(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/multi_schema' AS xdb (TYPE delta_classic, HANDOFF '100 milliseconds')")
+    conn.execute("SELECT COUNT(*) FROM xdb.schema1.table_x").fetchall()
+    conn.execute("DETACH xdb")
+    assert count_internal_databases(conn) == 1
+
+    # Released at the deadline, without any further delta_classic attach or detach
+    deadline = time.time() + 10
+    while count_internal_databases(conn) > 0:
+        assert time.time() < deadline, "handed off snapshot was not released"
+        time.sleep(0.05)
+
+
+def test_detach_without_handoff_releases_everything(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/multi_schema' AS pdb (TYPE delta_classic, PIN_SNAPSHOT)")
+    for table in ["schema1.table_x", "schema1.table_y", "schema2.table_z"]:
+        conn.execute(f"SELECT COUNT(*) FROM pdb.{table}").fetchall()
+    conn.execute("DETACH pdb")
+    assert count_internal_databases(conn) == 0
+
+
+def test_handoff_cannot_be_combined_with_as_of(conn):
+    with pytest.raises(Exception, match="AS_OF_TIMESTAMP cannot be combined"):
+        conn.execute(
+            "ATTACH 'test/data/multi_schema' AS adb "
+            "(TYPE delta_classic, HANDOFF '1 minute', AS_OF_TIMESTAMP '2030-01-01')"
+        )
@@ -0,0 +1,79 @@
+"""Test delta_classic_build_index: lookups on an indexed column skip the data files that cannot hold the key."""
+
+import shutil
+
+import pytest
+
+
+def key_index_logs(conn):
+    return [
+        row[0]
+        for row in conn.execute(
+            "SELECT message FROM duckdb_logs WHERE message LIKE 'delta_classic: key index%' ORDER BY timestamp"
+        ).fetchall()
+    ]
+
+
+def test_build_and_use_index(conn, tmp_path, copy_table, commit):
+    table_path = copy_table("partitioned") / "events"
+    index_dir = tmp_path / "index"
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute(f"ATTACH '{table_path.parent}' AS kdb (TYPE delta_classic, INDEX_DIRECTORY '{index_dir}')")
+
+    result = conn.execute("CALL delta_classic_build_index('kdb.main.events', 'id')").fetchall()
+    assert result == [(1, 2, 2)]
+    assert len(list(index_dir.glob("*.index"))) == 1
+
+    # No file holds the key: nothing is read
+    assert conn.execute("SELECT * FROM kdb.main.events WHERE id = 99").fetchall() == []
+    assert key_index_logs(conn)[-1].startswith("delta_classic: key index on 'id' selected 0 of 2 files")
+
+    # Every file holds the key: the scan is unchanged
+    rows = conn.execute("SELECT region, id FROM kdb.main.events WHERE id = 2 ORDER BY region").fetchall()
+    assert rows == [("eu", 2), ("us", 2)]
+
+    # A file committed after the index was built is always scanned
+    eu_file = next((table_path / "region=eu").glob("*.parquet"))
+    shutil.copy(eu_file, table_path / "region=eu" / "appended.parquet")
+    add = {
+        "path": "region=eu/appended.parquet",
+        "partitionValues": {"region": "eu"},
+        "size": eu_file.stat().st_size,
+        "modificationTime": 0,
+        "dataChange": True,
+    }
+    commit(table_path, 2, [{"add": add}])
+    rows = conn.execute("SELECT region, id, name FROM kdb.main.events WHERE id = 99 AND region = 'eu'").fetchall()
+    assert rows == []
+    assert key_index_logs(conn)[-1].startswith("delta_classic: key index on 'id' selected 1 of 3 files")
+
+    # Building again reads only the new file
+    result = conn.execute("CALL delta_classic_build_index('kdb.main.events', 'id')").fetchall()
+    assert result == [(2, 1, 3)]
+
+    conn.execute("DETACH kdb")
+
+
+def test_cached_small_table_ignores_index(conn, copy_table):
+    table_path = copy_table("partitioned") / "events"
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute(f"ATTACH '{table_path.parent}' AS kdb (TYPE delta_classic, PIN_SNAPSHOT, CACHE_SMALL_TABLES '64MB')")
+    conn.execute("CALL delta_classic_build_index('kdb.main.events', 'id')").fetchall()
+
+    # The table is served from memory; the index would read its files from storage again
+    assert conn.execute("SELECT * FROM kdb.main.events WHERE id = 99").fetchall() == []
+    assert conn.execute("SELECT COUNT(*) FROM kdb.main.events WHERE id = 2").fetchone()[0] == 2
+    assert key_index_logs(conn) == []
+    conn.execute("DETACH kdb")
+
+
+def test_index_errors(conn, copy_table):
+    table_path = copy_table("partitioned") / "events"
+    conn.execute(f"ATTACH '{table_path.parent}' AS kdb (TYPE delta_classic)")
+    with pytest.raises(Exception, match="partition column"):
+        conn.execute("CALL delta_classic_build_index('kdb.main.events', 'region')")
+    with pytest.raises(Exception, match="has no column"):
+        conn.execute("CALL delta_classic_build_index('kdb.main.events', 'missing')")
+    conn.execute("DETACH kdb")
@@ -0,0 +1,71 @@
+"""Test the LOCAL_CACHE block cache for data files."""
+
+import os
+
+import pytest
+
+
+def block_files(cache_dir):
+    return [name for name in os.listdir(cache_dir) if name.startswith("block_")]
+
+
+def test_local_cache_serves_repeated_reads(conn, tmp_path):
+    cache_dir = tmp_path / "cache"
+    conn.execute(f"ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, LOCAL_CACHE '{cache_dir}')")
+
+    first = conn.execute("SELECT * FROM cdb.main.table_a ORDER BY id").fetchall()
+    assert len(first) == 3
+    assert len(block_files(cache_dir)) > 0
+
+    second = conn.execute("SELECT * FROM cdb.main.table_a ORDER BY id").fetchall()
+    assert second == first
+
+    conn.execute("DETACH cdb")
+
+
+def test_local_cache_is_reused_by_next_attach(conn, tmp_path):
+    cache_dir = tmp_path / "cache"
+    conn.execute(f"ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, LOCAL_CACHE '{cache_dir}')")
+    expected = conn.execute("SELECT SUM(id) FROM cdb.main.table_b").fetchone()[0]
+    conn.execute("DETACH cdb")
+    cached = sorted(block_files(cache_dir))
+
+    conn.execute(f"ATTACH 'test/data/single_schema' AS cdb2 (TYPE delta_classic, LOCAL_CACHE '{cache_dir}')")
+    assert conn.execute("SELECT SUM(id) FROM cdb2.main.table_b").fetchone()[0] == expected
+    assert sorted(block_files(cache_dir)) == cached
+    conn.execute("DETACH cdb2")
+
+
+def test_handed_off_snapshot_outlives_cache_layer(conn, tmp_path):
+    cache_dir = tmp_path / "cache"
+    options = f"TYPE delta_classic, LOCAL_CACHE '{cache_dir}', HANDOFF '1 minute'"
+    conn.execute(f"ATTACH 'test/data/single_schema' AS cdb ({options})")
+    expected = conn.execute("SELECT * FROM cdb.main.table_a ORDER BY id").fetchall()
+    # The internal database, and any data file handles it keeps, survive the catalog and its cache layer
+    conn.execute("DETACH cdb")
+
+    conn.execute(f"ATTACH 'test/data/single_schema' AS cdb ({options})")
+    for _ in range(2):
+        assert conn.execute("SELECT * FROM cdb.main.table_a ORDER BY id").fetchall() == expected
+    conn.execute("DETACH cdb")
+
+
+def test_local_cache_size_bounds_directory(conn, tmp_path):
+    cache_dir = tmp_path / "cache"
+    conn.execute(
+        f"ATTACH 'test/data/multi_schema' AS cdb (TYPE delta_classic, LOCAL_CACHE '{cache_dir}', LOCAL_CACHE_SIZE '1KB')"
+    )
+    conn.execute("SELECT * FROM cdb.schema1.table_x").fetchall()
+    conn.execute("SELECT * FROM cdb.schema1.table_y").fetchall()
+    conn.execute("SELECT * FROM cdb.schema2.table_z").fetchall()
+
+    total = sum(os.path.getsize(cache_dir / name) for name in block_files(cache_dir))
+    assert total <= 1000
+    conn.execute("DETACH cdb")
+
+
+def test_invalid_local_cache_size(conn, tmp_path):
+    with pytest.raises(Exception):
+        conn.execute(
+            f"ATTACH 'test/data/single_schema' AS cdb (TYPE delta_classic, LOCAL_CACHE '{tmp_path}', LOCAL_CACHE_SIZE '0')"
+        )
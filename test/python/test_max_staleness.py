@@ -0,0 +1,106 @@
+"""Test MAX_STALENESS: pinned snapshots are replaced in the background once they are too old."""
+
+import time
+
+
+def wait_for(predicate, timeout=10):
+    deadline = time.time() + timeout
+    while not predicate():
+        assert time.time() < deadline, "timed out"
+        time.sleep(0.05)
+
+
+def count_rows(conn, db):
+    return conn.execute(f"SELECT COUNT(*) FROM {db}.main.table_a").fetchone()[0]
+
+
+def test_stale_snapshot_is_replaced(conn, copy_table, append_commit):
+    path = copy_table("single_schema")
+    conn.execute(f"ATTACH '{path}' AS sdb (TYPE delta_classic, MAX_STALENESS '100 milliseconds')")
+    assert count_rows(conn, "sdb") == 3
+
+    append_commit(path / "table_a", 3)
+    # A stale bind still reads the old snapshot and schedules the refresh
+    wait_for(lambda: count_rows(conn, "sdb") == 6)
+
+    # The replaced internal database is detached once no query uses it
+    wait_for(
+        lambda: conn.execute(
+            "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_sdb_%'"
+        ).fetchone()[0]
+        == 1
+    )
+
+    conn.execute("DETACH sdb")
+    orphaned = conn.execute(
+        "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_sdb_%'"
+    ).fetchone()[0]
+    assert orphaned == 0
+
+
+def test_pinned_snapshot_without_staleness_bound(conn, copy_table, append_commit):
+    path = copy_table("single_schema")
+    conn.execute(f"ATTACH '{path}' AS pdb (TYPE delta_classic, PIN_SNAPSHOT)")
+    assert count_rows(conn, "pdb") == 3
+
+    append_commit(path / "table_a", 3)
+    time.sleep(0.3)
+    assert count_rows(conn, "pdb") == 3
+
+    conn.execute("DETACH pdb")
+
+
+def test_invalid_max_staleness(conn):
+    try:
+        conn.execute("ATTACH 'test/data/single_schema' AS bad (TYPE delta_classic, MAX_STALENESS '-1 second')")
+        assert False, "expected an error"
+    except Exception as e:
+        assert "MAX_STALENESS must be positive" in str(e)
+
+
+def test_transaction_reads_one_version(conn, copy_table, append_commit):
+    path = copy_table("single_schema")
+    conn.execute(f"ATTACH '{path}' AS tdb (TYPE delta_classic, MAX_STALENESS '100 milliseconds')")
+    conn.execute("BEGIN TRANSACTION")
+    assert count_rows(conn, "tdb") == 3
+
+    append_commit(path / "table_a", 3)
+    time.sleep(0.3)
+    # Stale binds schedule a refresh, but the transaction keeps reading the version it started with
+    for _ in range(5):
+        assert count_rows(conn, "tdb") == 3
+        time.sleep(0.1)
+    conn.execute("COMMIT")
+
+    wait_for(lambda: count_rows(conn, "tdb") == 6)
+    conn.execute("DETACH tdb")
+
+
+def test_unpinned_statements_read_latest_version(conn, copy_table, append_commit):
+    path = copy_table("single_schema")
+    conn.execute(f"ATTACH '{path}' AS ldb (TYPE delta_classic)")
+    assert count_rows(conn, "ldb") == 3
+    assert len(conn.execute("SELECT id FROM ldb.main.table_a").fetchall()) == 3
+
+    # Each statement reads the latest version, whether answered from the log or scanned
+    append_commit(path / "table_a", 3)
+    assert count_rows(conn, "ldb") == 6
+    assert len(conn.execute("SELECT id FROM ldb.main.table_a").fetchall()) == 6
+    conn.execute("DETACH ldb")
+
+
+def test_unpinned_transaction_answers_and_scans_one_version(conn, copy_table, append_commit):
+    path = copy_table("single_schema")
+    conn.execute(f"ATTACH '{path}' AS udb (TYPE delta_classic)")
+    conn.execute("BEGIN TRANSACTION")
+    # Scanned first, so the version the transaction reads is fixed by the scan
+    assert len(conn.execute("SELECT id FROM udb.main.table_a").fetchall()) == 3
+
+    append_commit(path / "table_a", 3)
+    # COUNT(*) is answered from the log, at the version the scan read
+    assert count_rows(conn, "udb") == 3
+    assert len(conn.execute("SELECT id FROM udb.main.table_a").fetchall()) == 3
+    conn.execute("COMMIT")
+
+    assert count_rows(conn, "udb") == 6
+    conn.execute("DETACH udb")
@@ -0,0 +1,35 @@
+"""Test PREFETCH_FOOTERS: data file footers are read when a table is attached."""
+
+
+def prefetch_logs(conn):
+    return [
+        row[0]
+        for row in conn.execute(
+            "SELECT message FROM duckdb_logs WHERE message LIKE 'delta_classic: prefetched%'"
+        ).fetchall()
+    ]
+
+
+def test_footers_prefetched_on_attach(conn):
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute("ATTACH 'test/data/multi_schema' AS fdb (TYPE delta_classic, PIN_SNAPSHOT, PREFETCH_FOOTERS)")
+
+    assert conn.execute("SELECT SUM(id) FROM fdb.schema1.table_x").fetchone()[0] == 15
+    logs = prefetch_logs(conn)
+    assert len(logs) == 1
+    assert logs[0].startswith("delta_classic: prefetched 1 of 1 footers")
+
+    # Scans served from the prefetched footers read the same data
+    ids = conn.execute("SELECT id FROM fdb.schema1.table_x ORDER BY id").fetchall()
+    assert ids == [(1,), (2,), (3,), (4,), (5,)]
+
+    conn.execute("DETACH fdb")
+
+
+def test_prefetch_with_local_cache(conn, tmp_path):
+    conn.execute(
+        f"ATTACH 'test/data/single_schema' AS fdb (TYPE delta_classic, PREFETCH_FOOTERS, LOCAL_CACHE '{tmp_path}')"
+    )
+    assert conn.execute("SELECT COUNT(*) FROM (SELECT * FROM fdb.main.table_a)").fetchone()[0] == 3
+    conn.execute("DETACH fdb")
@@ -0,0 +1,27 @@
+"""Test DISCOVERY_MODE 'recursive' on layouts where schemas nest inside each other."""
+import shutil
+
+SOURCE_TABLE = "test/data/single_schema/table_a"
+
+
+def make_table(root, relative_path):
+    shutil.copytree(SOURCE_TABLE, root / relative_path)
+
+
+def test_interleaved_nested_schemas(conn, tmp_path):
+    # Sorted paths put region/a/history/orders between the other two tables of schema region/a
+    for table in ["region/a/customers", "region/a/history/orders", "region/a/products"]:
+        make_table(tmp_path, table)
+    conn.execute(f"ATTACH '{tmp_path}' AS ndb (TYPE delta_classic, DISCOVERY_MODE 'recursive')")
+
+    tables = conn.execute(
+        "SELECT schema_name, table_name FROM duckdb_tables() WHERE database_name = 'ndb' ORDER BY ALL"
+    ).fetchall()
+    assert tables == [
+        ("region/a", "customers"),
+        ("region/a", "products"),
+        ("region/a/history", "orders"),
+    ]
+    assert conn.execute('SELECT COUNT(*) FROM ndb."region/a".customers').fetchone()[0] == 3
+    assert conn.execute('SELECT COUNT(*) FROM ndb."region/a".products').fetchone()[0] == 3
+    conn.execute("DETACH ndb")
@@ -0,0 +1,81 @@
+"""Test refreshing a catalog after tables are added to or removed from storage."""
+
+import shutil
+import time
+
+
+def table_names(conn, db, schema):
+    return sorted(
+        r[0]
+        for r in conn.execute(
+            "SELECT table_name FROM duckdb_tables() WHERE database_name = ? AND schema_name = ?", [db, schema]
+        ).fetchall()
+    )
+
+
+def test_refresh_adds_and_removes_tables(conn, copy_table):
+    path = copy_table("multi_schema")
+    conn.execute(f"ATTACH '{path}' AS rdb (TYPE delta_classic)")
+    assert conn.execute("SELECT COUNT(*) FROM rdb.schema1.table_x").fetchone()[0] == 5
+    assert table_names(conn, "rdb", "schema1") == ["table_x", "table_y"]
+
+    shutil.copytree(path / "schema1" / "table_x", path / "schema1" / "table_new")
+    shutil.rmtree(path / "schema1" / "table_y")
+    shutil.copytree(path / "schema2", path / "schema3")
+
+    result = conn.execute("CALL delta_classic_refresh('rdb')").fetchall()
+    assert result == [(1, 0, 1, 1)]
+
+    assert table_names(conn, "rdb", "schema1") == ["table_new", "table_x"]
+    assert conn.execute("SELECT COUNT(*) FROM rdb.schema1.table_new").fetchone()[0] == 5
+    assert conn.execute("SELECT COUNT(*) FROM rdb.schema3.table_z").fetchone()[0] == 3
+
+    # The unchanged table kept its attachment
+    internal = conn.execute(
+        "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name = '__dc_rdb_schema1_table_x'"
+    ).fetchone()[0]
+    assert internal == 1
+
+    # Nothing changed since the last refresh
+    assert conn.execute("CALL delta_classic_refresh('rdb')").fetchall() == [(0, 0, 0, 0)]
+
+    conn.execute("DETACH rdb")
+
+
+def test_refresh_removed_schema(conn, copy_table):
+    path = copy_table("multi_schema")
+    conn.execute(f"ATTACH '{path}' AS sdb (TYPE delta_classic)")
+    assert conn.execute("SELECT COUNT(*) FROM sdb.schema2.table_z").fetchone()[0] == 3
+
+    shutil.rmtree(path / "schema2")
+    assert conn.execute("CALL delta_classic_refresh('sdb')").fetchall() == [(0, 1, 0, 1)]
+
+    internal = conn.execute(
+        "SELECT COUNT(*) FROM duckdb_databases() WHERE database_name LIKE '__dc_sdb_%'"
+    ).fetchone()[0]
+    assert internal == 0
+
+    conn.execute("DETACH sdb")
+
+
+def test_refresh_requires_delta_classic_database(conn):
+    conn.execute("ATTACH ':memory:' AS plain")
+    try:
+        conn.execute("CALL delta_classic_refresh('plain')")
+        assert False, "expected an error"
+    except Exception as e:
+        assert "not a delta_classic database" in str(e)
+
+
+def test_refresh_interval(conn, copy_table):
+    path = copy_table("multi_schema")
+    conn.execute(f"ATTACH '{path}' AS idb (TYPE delta_classic, REFRESH_INTERVAL '100 milliseconds')")
+    assert table_names(conn, "idb", "schema2") == ["table_z"]
+
+    shutil.copytree(path / "schema2" / "table_z", path / "schema2" / "table_w")
+    deadline = time.time() + 10
+    while table_names(conn, "idb", "schema2") != ["table_w", "table_z"]:
+        assert time.time() < deadline, "background refresh did not pick up the new table"
+        time.sleep(0.1)
+
+    conn.execute("DETACH idb")
@@ -0,0 +1,81 @@
+"""Test REPLICA: tables are copied into a local DuckDB database and scans read the copy."""
+
+import shutil
+
+
+def replica_logs(conn):
+    return [
+        row[0]
+        for row in conn.execute(
+            "SELECT message FROM duckdb_logs WHERE message LIKE 'delta_classic: replica % files%' ORDER BY timestamp"
+        ).fetchall()
+    ]
+
+
+def test_replica_copies_appends_and_serves(conn, tmp_path, copy_table, commit):
+    table_path = copy_table("partitioned") / "events"
+    replica = tmp_path / "replica.duckdb"
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute(f"ATTACH '{table_path.parent}' AS rdb (TYPE delta_classic, REPLICA '{replica}')")
+
+    # A refresh waits for the copy started by the attach
+    conn.execute("CALL delta_classic_refresh('rdb')")
+    logs = replica_logs(conn)
+    assert len(logs) == 1
+    assert logs[0].startswith("delta_classic: replica copied 2 files")
+
+    # Scans read the copy, so they work without the data files
+    data_files = tmp_path / "data_files"
+    shutil.copytree(table_path, data_files, ignore=shutil.ignore_patterns("_delta_log"))
+    for directory in ["region=eu", "region=us"]:
+        shutil.rmtree(table_path / directory)
+    rows = conn.execute("SELECT region, COUNT(*) FROM rdb.main.events GROUP BY region ORDER BY region").fetchall()
+    assert rows == [("eu", 3), ("us", 3)]
+    shutil.copytree(data_files, table_path, dirs_exist_ok=True)
+
+    # A commit that only adds a file is applied by appending that file
+    eu_file = next((table_path / "region=eu").glob("*.parquet"))
+    shutil.copy(eu_file, table_path / "region=eu" / "appended.parquet")
+    add = {
+        "path": "region=eu/appended.parquet",
+        "partitionValues": {"region": "eu"},
+        "size": eu_file.stat().st_size,
+        "modificationTime": 0,
+        "dataChange": True,
+    }
+    commit(table_path, 2, [{"add": add}])
+    conn.execute("CALL delta_classic_refresh('rdb')")
+    assert replica_logs(conn)[-1].startswith("delta_classic: replica appended 1 files")
+    assert conn.execute("SELECT COUNT(*) FROM rdb.main.events WHERE region = 'eu'").fetchone()[0] == 6
+
+    # Removing a file copies the table again
+    commit(table_path, 3, [{"remove": {"path": "region=eu/appended.parquet", "dataChange": True}}])
+    conn.execute("CALL delta_classic_refresh('rdb')")
+    assert replica_logs(conn)[-1].startswith("delta_classic: replica copied 2 files")
+    assert conn.execute("SELECT COUNT(*) FROM rdb.main.events").fetchone()[0] == 6
+    conn.execute("DETACH rdb")
+
+    # The replica remembers the copied versions, so attaching it again copies nothing
+    copies = len(replica_logs(conn))
+    conn.execute(f"ATTACH '{table_path.parent}' AS rdb (TYPE delta_classic, REPLICA '{replica}')")
+    conn.execute("CALL delta_classic_refresh('rdb')")
+    assert len(replica_logs(conn)) == copies
+    assert conn.execute("SELECT COUNT(*) FROM rdb.main.events").fetchone()[0] == 6
+    conn.execute("DETACH rdb")
+
+
+def test_replica_copies_table_after_added_column(conn, tmp_path, copy_table, add_column, enable_logging, count_logs):
+    table_path = copy_table("partitioned") / "events"
+    replica = tmp_path / "replica.duckdb"
+    enable_logging(conn)
+    conn.execute(f"ATTACH '{table_path.parent}' AS rdb (TYPE delta_classic, REPLICA '{replica}')")
+    conn.execute("CALL delta_classic_refresh('rdb')")
+
+    # No data file holds the new column yet: the copy reads it as NULL
+    add_column(table_path, 2, "score", "long")
+    conn.execute("CALL delta_classic_refresh('rdb')")
+    assert replica_logs(conn)[-1].startswith("delta_classic: replica copied 2 files")
+    assert count_logs(conn, "delta_classic: replica failed%") == 0
+    assert conn.execute("SELECT COUNT(*), COUNT(score) FROM __dc_replica_rdb.main.events").fetchone() == (6, 0)
+    conn.execute("DETACH rdb")
@@ -0,0 +1,43 @@
+"""Test that pinned catalogs attaching the same path share internal delta databases."""
+
+
+def test_pinned_catalogs_share_snapshot(conn, count_logs, count_internal_databases):
+    conn.execute("SET enable_logging = true")
+    conn.execute("SET logging_level = 'info'")
+    conn.execute("ATTACH 'test/data/multi_schema' AS share1 (TYPE delta_classic, PIN_SNAPSHOT)")
+    conn.execute("ATTACH 'test/data/multi_schema' AS share2 (TYPE delta_classic, PIN_SNAPSHOT)")
+
+    assert conn.execute("SELECT COUNT(*) FROM share1.schema1.table_x").fetchone()[0] == 5
+    assert conn.execute("SELECT COUNT(*) FROM share2.schema1.table_x").fetchone()[0] == 5
+
+    assert count_logs(conn, "delta_classic: attached%table_x%") == 1
+    assert count_logs(conn, "delta_classic: shared%table_x%") == 1
+    assert count_internal_databases(conn) == 1
+
+
+def test_shared_snapshot_survives_first_detach(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/multi_schema' AS share1 (TYPE delta_classic, PIN_SNAPSHOT)")
+    conn.execute("ATTACH 'test/data/multi_schema' AS share2 (TYPE delta_classic, PIN_SNAPSHOT)")
+    conn.execute("SELECT COUNT(*) FROM share1.schema1.table_x").fetchall()
+    conn.execute("SELECT COUNT(*) FROM share2.schema1.table_x").fetchall()
+
+    # The internal database was attached for share1, but share2 still uses it
+    conn.execute("DETACH share1")
+    assert count_internal_databases(conn) == 1
+    assert conn.execute("SELECT SUM(id) FROM share2.schema1.table_x").fetchone()[0] == 15
+
+    conn.execute("DETACH share2")
+    assert count_internal_databases(conn) == 0
+
+
+def test_unpinned_catalogs_do_not_share(conn, count_internal_databases):
+    conn.execute("ATTACH 'test/data/multi_schema' AS own1 (TYPE delta_classic)")
+    conn.execute("ATTACH 'test/data/multi_schema' AS own2 (TYPE delta_classic)")
+    conn.execute("SELECT COUNT(*) FROM own1.schema1.table_x").fetchall()
+    conn.execute("SELECT COUNT(*) FROM own2.schema1.table_x").fetchall()
+
+    assert count_internal_databases(conn) == 2
+
+    conn.execute("DETACH own1")
+    conn.execute("DETACH own2")
+    assert count_internal_databases(conn) == 0
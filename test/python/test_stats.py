@@ -0,0 +1,115 @@
+"""Test delta_classic_stats: timings and counters of discovery, attaches and scans."""
+import pytest
+
+
+def get_stats(conn, database=None):
+    query = "SELECT schema_name, table_name, metric, unit, count, total, min, max, p50, p99 FROM "
+    query += f"delta_classic_stats('{database}')" if database else "delta_classic_stats()"
+    rows = conn.execute(query).fetchall()
+    return {(row[0], row[1], row[2]): row[3:] for row in rows}
+
+
+def test_table_metrics(conn):
+    conn.execute("ATTACH 'test/data/multi_schema' AS sdb (TYPE delta_classic, PIN_SNAPSHOT)")
+    conn.execute("SELECT COUNT(*) FROM sdb.schema1.table_x").fetchall()
+    conn.execute("SELECT SUM(id) FROM sdb.schema1.table_x").fetchall()
+
+    stats = get_stats(conn, "sdb")
+    unit, count, total, minimum, maximum, p50, p99 = stats[("schema1", "table_x", "attach")]
+    assert unit == "us"
+    assert count == 1
+    assert total == minimum == maximum > 0
+    assert minimum <= p50 <= p99 <= maximum
+
+    assert stats[("schema1", "table_x", "binds")][:2] == ("calls", 2)
+    unit, count, total, minimum, maximum, _, _ = stats[("schema1", "table_x", "scanned_table_bytes")]
+    assert unit == "bytes"
+    assert count == 2
+    assert minimum == maximum > 0
+    assert total == 2 * minimum
+
+    # Counters have no distribution
+    assert stats[("schema1", "table_x", "binds")][2:] == (None, None, None, None, None)
+    # Tables that were never queried have no rows
+    assert not any(key[1] == "table_y" for key in stats)
+    conn.execute("DETACH sdb")
+
+
+def test_read_bytes(conn, tmp_path):
+    conn.execute(
+        f"ATTACH 'test/data/multi_schema' AS cdb (TYPE delta_classic, LOCAL_CACHE '{tmp_path / 'cache'}')"
+    )
+    conn.execute("SELECT SUM(id) FROM cdb.schema1.table_x").fetchall()
+    stats = get_stats(conn, "cdb")
+    unit, fetched = stats[(None, None, "storage_read_bytes")][:2]
+    assert unit == "bytes"
+    assert fetched > 0
+
+    # Served from the local cache the second time
+    conn.execute("SELECT SUM(id) FROM cdb.schema1.table_x").fetchall()
+    stats = get_stats(conn, "cdb")
+    assert stats[(None, None, "storage_read_bytes")][1] == fetched
+    assert stats[(None, None, "cache_read_bytes")][1] > 0
+    conn.execute("DETACH cdb")
+
+
+def test_discovery_metrics(conn):
+    conn.execute("ATTACH 'test/data/multi_schema' AS ddb (TYPE delta_classic)")
+    conn.execute("SELECT COUNT(*) FROM ddb.schema1.table_x").fetchall()
+
+    stats = get_stats(conn, "ddb")
+    assert stats[(None, None, "discovery")][1] == 1
+    assert stats[(None, None, "list_calls")][1] >= 1
+    # The table was resolved by checking for its _delta_log, without listing the schema
+    assert stats[("schema1", None, "probe")][1] == 1
+    assert stats[("schema1", None, "exists_calls")][1] == 1
+    assert ("schema1", None, "list_tables") not in stats
+
+    conn.execute("SELECT COUNT(*) FROM duckdb_tables() WHERE database_name = 'ddb'").fetchall()
+    stats = get_stats(conn, "ddb")
+    assert stats[("schema1", None, "list_tables")][1] == 1
+    assert stats[("schema1", None, "list_calls")][1] == 1
+    conn.execute("DETACH ddb")
+
+
+def test_all_databases(conn):
+    conn.execute("ATTACH 'test/data/single_schema' AS adb1 (TYPE delta_classic)")
+    conn.execute("ATTACH 'test/data/multi_schema' AS adb2 (TYPE delta_classic)")
+    conn.execute("SELECT COUNT(*) FROM adb1.main.table_a").fetchall()
+    conn.execute("SELECT COUNT(*) FROM adb2.schema1.table_x").fetchall()
+
+    databases = conn.execute("SELECT DISTINCT database_name FROM delta_classic_stats() ORDER BY 1").fetchall()
+    assert databases == [("adb1",), ("adb2",)]
+    conn.execute("DETACH adb1")
+    conn.execute("DETACH adb2")
+
+
+def test_explain_shows_snapshot(conn):
+    conn.execute("ATTACH 'test/data/multi_schema' AS edb (TYPE delta_classic, PIN_SNAPSHOT)")
+    conn.execute("SELECT COUNT(*) FROM edb.schema1.table_x").fetchall()
+    plan = conn.execute("EXPLAIN SELECT * FROM edb.schema1.table_x").fetchall()[0][1]
+    assert "Delta Table" in plan
+    assert "Delta Version" in plan
+    conn.execute("DETACH edb")
+
+
+def test_explain_in_separate_databases(conn, extension_path):
+    import duckdb
+
+    other = duckdb.connect(config={"allow_unsigned_extensions": "true"})
+    other.execute(f"INSTALL '{extension_path}'")
+    conn.execute("ATTACH 'test/data/multi_schema' AS mdb (TYPE delta_classic)")
+    other.execute("ATTACH 'test/data/single_schema' AS sdb (TYPE delta_classic)")
+    # Each database instance describes its own scans
+    for _ in range(3):
+        plan = conn.execute("EXPLAIN SELECT * FROM mdb.schema1.table_x").fetchall()[0][1]
+        assert "table_x" in plan and "table_a" not in plan
+        plan = other.execute("EXPLAIN SELECT * FROM sdb.main.table_a").fetchall()[0][1]
+        assert "table_a" in plan and "table_x" not in plan
+    other.close()
+    conn.execute("DETACH mdb")
+
+
+def test_not_a_delta_classic_database(conn):
+    with pytest.raises(Exception, match="not a delta_classic database"):
+        conn.execute("SELECT * FROM delta_classic_stats('memory')")
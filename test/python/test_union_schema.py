@@ -0,0 +1,93 @@
+"""Test querying one table name across all schemas through the __all__ schema."""
+
+import shutil
+
+import duckdb
+import pytest
+
+
+def copy_lakehouse(copy_table):
+    path = copy_table("multi_schema")
+    # Every schema now has a table_x
+    shutil.copytree(path / "schema1" / "table_x", path / "schema2" / "table_x")
+    return path
+
+
+def internal_databases(conn, db):
+    return sorted(
+        r[0]
+        for r in conn.execute(
+            "SELECT database_name FROM duckdb_databases() WHERE database_name LIKE ?", [f"__dc_{db}_%"]
+        ).fetchall()
+    )
+
+
+def test_union_across_schemas(conn, copy_table):
+    path = copy_lakehouse(copy_table)
+    conn.execute(f"ATTACH '{path}' AS udb (TYPE delta_classic)")
+
+    result = conn.execute(
+        "SELECT schema_name, COUNT(*), SUM(amount) FROM udb.__all__.table_x GROUP BY schema_name ORDER BY 1"
+    ).fetchall()
+    assert result == [("schema1", 5, 1000), ("schema2", 5, 1000)]
+
+    # Columns of the table itself do not include the schema name
+    columns = [d[0] for d in conn.execute("SELECT * FROM udb.__all__.table_x").description]
+    assert "schema_name" not in columns
+    assert "id" in columns
+
+    # A table found in one schema only
+    result = conn.execute("SELECT DISTINCT schema_name FROM udb.__all__.table_z").fetchall()
+    assert result == [("schema2",)]
+
+    conn.execute("DETACH udb")
+
+
+def test_union_has_columns_of_every_schema(conn, copy_table, add_column):
+    path = copy_lakehouse(copy_table)
+    # Only the table of the second schema has the column
+    add_column(path / "schema2" / "table_x", 1, "note", "string")
+    conn.execute(f"ATTACH '{path}' AS ndb (TYPE delta_classic)")
+
+    columns = [d[0] for d in conn.execute("SELECT * FROM ndb.__all__.table_x").description]
+    assert "note" in columns
+    result = conn.execute(
+        "SELECT schema_name, COUNT(*), COUNT(note) FROM ndb.__all__.table_x GROUP BY schema_name ORDER BY 1"
+    ).fetchall()
+    assert result == [("schema1", 5, 0), ("schema2", 5, 0)]
+
+
+def test_schema_filter_prunes_schemas(conn, copy_table):
+    path = copy_lakehouse(copy_table)
+    conn.execute(f"ATTACH '{path}' AS pdb (TYPE delta_classic)")
+
+    result = conn.execute("SELECT SUM(id) FROM pdb.__all__.table_x WHERE schema_name = 'schema2'").fetchone()[0]
+    assert result == 15
+    # The excluded schema's table was never attached
+    assert internal_databases(conn, "pdb") == ["__dc_pdb_schema2_table_x"]
+
+    # Filters on other columns do not prune
+    result = conn.execute(
+        "SELECT COUNT(*) FROM pdb.__all__.table_x WHERE schema_name LIKE 'schema%' AND region = 'east'"
+    ).fetchone()[0]
+    assert result == 6
+
+    # No schema matches
+    result = conn.execute("SELECT COUNT(*) FROM pdb.__all__.table_x WHERE schema_name = 'schema9'").fetchone()[0]
+    assert result == 0
+
+    conn.execute("DETACH pdb")
+
+
+def test_union_schema_not_listed(conn):
+    conn.execute("ATTACH 'test/data/multi_schema' AS ldb (TYPE delta_classic)")
+    schemas = [
+        r[0]
+        for r in conn.execute("SELECT schema_name FROM duckdb_schemas() WHERE database_name = 'ldb'").fetchall()
+    ]
+    assert "__all__" not in schemas
+
+    with pytest.raises(duckdb.CatalogException):
+        conn.execute("SELECT * FROM ldb.__all__.no_such_table")
+
+    conn.execute("DETACH ldb")